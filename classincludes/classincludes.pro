@@ -92,6 +92,17 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtLegendData \
         QwtLegendLabel \
         QwtPointMapper \
+        QwtSeriesLoader \
+        QwtItemModelPointData \
+        QwtCompressedPointData \
+        QwtSharedXColumnData \
+        QwtSharedXColumn \
+        QwtMappedPointData \
+        QwtPointStreamData \
+        QwtRingBufferData \
+        QwtSpatialIndex \
+        QwtPointPyramidData \
+        QwtMinMaxPyramid \
         QwtMatrixRasterData \
         QwtOHLCSample \
         QwtPlot \
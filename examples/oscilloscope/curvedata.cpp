@@ -13,7 +13,7 @@ SignalData &CurveData::values()
 
 QPointF CurveData::sample( size_t i ) const
 {
-    return SignalData::instance().value( i );
+    return SignalData::instance().sample( i );
 }
 
 size_t CurveData::size() const
@@ -21,6 +21,12 @@ size_t CurveData::size() const
     return SignalData::instance().size();
 }
 
+void CurveData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    SignalData::instance().copySamples( from, count, samples );
+}
+
 QRectF CurveData::boundingRect() const
 {
     return SignalData::instance().boundingRect();
@@ -11,6 +11,8 @@ public:
 
     virtual QPointF sample( size_t i ) const;
     virtual size_t size() const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
 
     virtual QRectF boundingRect() const;
 };
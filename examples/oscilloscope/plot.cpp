@@ -129,12 +129,9 @@ void Plot::start()
 void Plot::replot()
 {
     CurveData *data = static_cast<CurveData *>( d_curve->data() );
-    data->values().lock();
 
     QwtPlot::replot();
     d_paintedPoints = data->size();
-
-    data->values().unlock();
 }
 
 void Plot::setIntervalLength( double interval )
@@ -152,7 +149,14 @@ void Plot::setIntervalLength( double interval )
 void Plot::updateCurve()
 {
     CurveData *data = static_cast<CurveData *>( d_curve->data() );
-    data->values().lock();
+    data->values().update();
+
+    if ( data->values().releaseSpace() )
+    {
+        // the indices of the painted points have changed
+        replot();
+        return;
+    }
 
     const int numPoints = data->size();
     if ( numPoints > d_paintedPoints )
@@ -181,8 +185,6 @@ void Plot::updateCurve()
             d_paintedPoints - 1, numPoints - 1 );
         d_paintedPoints = numPoints;
     }
-
-    data->values().unlock();
 }
 
 void Plot::incrementInterval()
@@ -38,8 +38,15 @@ void SamplingThread::sample( double elapsed )
 {
     if ( d_frequency > 0.0 )
     {
-        const QPointF s( elapsed, value( elapsed ) );
-        SignalData::instance().append( s );
+        d_pending += QPointF( elapsed, value( elapsed ) );
+
+        // When the ring buffer is full, the values are kept back
+        // until the GUI thread has released the oldest ones
+
+        const size_t numAppended = SignalData::instance().append( 
+            d_pending.constData(), d_pending.size() );
+
+        d_pending.remove( 0, static_cast<int>( numAppended ) );
     }
 }
 
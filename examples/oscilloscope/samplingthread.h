@@ -1,4 +1,6 @@
 #include <qwt_sampling_thread.h>
+#include <qvector.h>
+#include <qpoint.h>
 
 class SamplingThread: public QwtSamplingThread
 {
@@ -22,4 +24,7 @@ private:
 
     double d_frequency;
     double d_amplitude;
+
+    // values, that didn't fit into the ring buffer
+    QVector<QPointF> d_pending;
 };
@@ -1,33 +1,19 @@
 #ifndef _SIGNAL_DATA_H_
 #define _SIGNAL_DATA_H_ 1
 
-#include <qrect.h>
+#include <qwt_ring_buffer_data.h>
 
-class SignalData
+class SignalData: public QwtRingBufferData
 {
 public:
     static SignalData &instance();
 
-    void append( const QPointF &pos );
     void clearStaleValues( double min );
-
-    int size() const;
-    QPointF value( int index ) const;
-
-    QRectF boundingRect() const;
-
-    void lock();
-    void unlock();
+    bool releaseSpace();
 
 private:
     SignalData();
-    SignalData( const SignalData & );
-    SignalData &operator=( const SignalData & );
-
     virtual ~SignalData();
-
-    class PrivateData;
-    PrivateData *d_data;
 };
 
 #endif
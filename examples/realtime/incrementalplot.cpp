@@ -4,37 +4,10 @@
 #include <qwt_symbol.h>
 #include <qwt_plot_directpainter.h>
 #include <qwt_painter.h>
+#include <qwt_point_stream_data.h>
 #include "incrementalplot.h"
 #include <qpaintengine.h>
 
-class CurveData: public QwtArraySeriesData<QPointF>
-{
-public:
-    CurveData()
-    {
-    }
-
-    virtual QRectF boundingRect() const
-    {
-        if ( d_boundingRect.width() < 0.0 )
-            d_boundingRect = qwtBoundingRect( *this );
-
-        return d_boundingRect;
-    }
-
-    inline void append( const QPointF &point )
-    {
-        d_samples += point;
-    }
-
-    void clear()
-    {
-        d_samples.clear();
-        d_samples.squeeze();
-        d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
-    }
-};
-
 IncrementalPlot::IncrementalPlot( QWidget *parent ):
     QwtPlot( parent ),
     d_curve( NULL )
@@ -50,7 +23,7 @@ IncrementalPlot::IncrementalPlot( QWidget *parent ):
     }
 
     d_curve = new QwtPlotCurve( "Test Curve" );
-    d_curve->setData( new CurveData() );
+    d_curve->setData( new QwtPointStreamData() );
     showSymbols( true );
 
     d_curve->attach( this );
@@ -65,7 +38,12 @@ IncrementalPlot::~IncrementalPlot()
 
 void IncrementalPlot::appendPoint( const QPointF &point )
 {
-    CurveData *data = static_cast<CurveData *>( d_curve->data() );
+    // QwtPointStreamData stores the points in blocks, that are
+    // never reallocated, and updates the bounding rectangle
+    // incrementally
+
+    QwtPointStreamData *data = 
+        static_cast<QwtPointStreamData *>( d_curve->data() );
     data->append( point );
 
     const bool doClip = !canvas()->testAttribute( Qt::WA_PaintOnScreen );
@@ -99,7 +77,8 @@ void IncrementalPlot::appendPoint( const QPointF &point )
 
 void IncrementalPlot::clearPoints()
 {
-    CurveData *data = static_cast<CurveData *>( d_curve->data() );
+    QwtPointStreamData *data = 
+        static_cast<QwtPointStreamData *>( d_curve->data() );
     data->clear();
 
     replot();
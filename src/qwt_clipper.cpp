@@ -300,6 +300,151 @@ private:
     const Rect d_clipRect;
 };
 
+static inline double qwtClipValue( double value, double )
+{
+    return value;
+}
+
+static inline int qwtClipValue( double value, int )
+{
+    return qRound( value );
+}
+
+static inline bool qwtClipT( double p, double q, double &t0, double &t1 )
+{
+    if ( p == 0.0 )
+        return q >= 0.0;
+
+    const double r = q / p;
+    if ( p < 0.0 )
+    {
+        if ( r > t1 )
+            return false;
+
+        if ( r > t0 )
+            t0 = r;
+    }
+    else
+    {
+        if ( r < t0 )
+            return false;
+
+        if ( r < t1 )
+            t1 = r;
+    }
+
+    return true;
+}
+
+// Liang-Barsky
+static inline bool qwtClipLine( double x1, double y1, double dx, double dy,
+    double xMin, double xMax, double yMin, double yMax, double &t0, double &t1 )
+{
+    t0 = 0.0;
+    t1 = 1.0;
+
+    return qwtClipT( -dx, x1 - xMin, t0, t1 )
+        && qwtClipT( dx, xMax - x1, t0, t1 )
+        && qwtClipT( -dy, y1 - yMin, t0, t1 )
+        && qwtClipT( dy, yMax - y1, t0, t1 );
+}
+
+template <class Polygon, class Rect, class Point, typename T>
+class QwtPolylineClipper
+{
+public:
+    explicit QwtPolylineClipper( const Rect &clipRect ):
+        d_x1( clipRect.x() ),
+        d_x2( clipRect.x() + clipRect.width() ),
+        d_y1( clipRect.y() ),
+        d_y2( clipRect.y() + clipRect.height() )
+    {
+    }
+
+    QVector<Polygon> clipPolyline( const Polygon &polyline ) const
+    {
+        QVector<Polygon> polylines;
+
+        const int numPoints = polyline.size();
+        const Point *points = polyline.constData();
+
+        if ( numPoints == 1 )
+        {
+            if ( points[0].x() >= d_x1 && points[0].x() <= d_x2
+                && points[0].y() >= d_y1 && points[0].y() <= d_y2 )
+            {
+                polylines += polyline;
+            }
+
+            return polylines;
+        }
+
+        Polygon run;
+
+        for ( int i = 1; i < numPoints; i++ )
+        {
+            Point p1 = points[i - 1];
+            Point p2 = points[i];
+
+            if ( !clipLine( p1, p2 ) )
+                continue;
+
+            if ( !run.isEmpty() && run.last() != p1 )
+            {
+                // the polyline has left the rectangle in between
+                polylines += run;
+                run.clear();
+            }
+
+            if ( run.isEmpty() )
+                run += p1;
+
+            if ( run.last() != p2 )
+                run += p2;
+        }
+
+        if ( !run.isEmpty() )
+            polylines += run;
+
+        return polylines;
+    }
+
+private:
+    inline bool clipLine( Point &p1, Point &p2 ) const
+    {
+        const double x1 = p1.x();
+        const double y1 = p1.y();
+        const double dx = p2.x() - x1;
+        const double dy = p2.y() - y1;
+
+        double t0, t1;
+        if ( !qwtClipLine( x1, y1, dx, dy, 
+            d_x1, d_x2, d_y1, d_y2, t0, t1 ) )
+        {
+            return false;
+        }
+
+        if ( t1 < 1.0 )
+        {
+            p2 = Point( qwtClipValue( x1 + t1 * dx, T() ),
+                qwtClipValue( y1 + t1 * dy, T() ) );
+        }
+
+        if ( t0 > 0.0 )
+        {
+            p1 = Point( qwtClipValue( x1 + t0 * dx, T() ),
+                qwtClipValue( y1 + t0 * dy, T() ) );
+        }
+
+        return true;
+    }
+
+    const T d_x1;
+    const T d_x2;
+    const T d_y1;
+    const T d_y2;
+};
+
 class QwtCircleClipper
 {
 public:
@@ -489,6 +634,71 @@ QPolygonF QwtClipper::clipPolygonF(
     return clipper.clipPolygon( polygon, closePolygon );
 }
 
+/*!
+   \brief Polyline clipping
+
+   In opposite to clipPolygon() the parts of the polyline outside 
+   of the clip rectangle are not replaced by lines on its border,
+   but the polyline is split into the runs of lines inside. Each line 
+   is clipped by the Liang-Barsky algorithm and consecutive lines
+   are merged into the same run.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Parts of the polyline inside of the clip rectangle
+*/
+QVector<QPolygon> QwtClipper::clipPolyline(
+    const QRect &clipRect, const QPolygon &polyline )
+{
+    QwtPolylineClipper<QPolygon, QRect, QPoint, int> clipper( clipRect );
+    return clipper.clipPolyline( polyline );
+}
+
+/*!
+   \brief Polyline clipping
+
+   In opposite to clipPolygonF() the parts of the polyline outside 
+   of the clip rectangle are not replaced by lines on its border,
+   but the polyline is split into the runs of lines inside. Each line 
+   is clipped by the Liang-Barsky algorithm and consecutive lines
+   are merged into the same run.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Parts of the polyline inside of the clip rectangle
+*/
+QVector<QPolygonF> QwtClipper::clipPolylineF(
+    const QRectF &clipRect, const QPolygonF &polyline )
+{
+    QwtPolylineClipper<QPolygonF, QRectF, QPointF, double> clipper( clipRect );
+    return clipper.clipPolyline( polyline );
+}
+
+/*!
+   \brief Line clipping
+
+   Calculates the part of the line from p1 to p2 inside of the
+   clip rectangle by the Liang-Barsky algorithm. The part inside
+   are the points p1 + t * ( p2 - p1 ) with t0 <= t <= t1.
+
+   \param clipRect Clip rectangle
+   \param p1 Start point of the line
+   \param p2 End point of the line
+   \param t0 Parameter of the point, where the line enters the rectangle
+   \param t1 Parameter of the point, where the line leaves the rectangle
+
+   \return false, when the line is completely outside
+*/
+bool QwtClipper::clipLine( const QRectF &clipRect, 
+    const QPointF &p1, const QPointF &p2, double &t0, double &t1 )
+{
+    return qwtClipLine( p1.x(), p1.y(), p2.x() - p1.x(), p2.y() - p1.y(),
+        clipRect.left(), clipRect.right(), clipRect.top(), clipRect.bottom(),
+        t0, t1 );
+}
+
 /*!
    Circle clipping
 
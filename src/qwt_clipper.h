@@ -33,6 +33,15 @@ public:
     static QPolygonF clipPolygonF( const QRectF &, 
         const QPolygonF &, bool closePolygon = false );
 
+    static QVector<QPolygon> clipPolyline( 
+        const QRect &, const QPolygon & );
+
+    static QVector<QPolygonF> clipPolylineF( 
+        const QRectF &, const QPolygonF & );
+
+    static bool clipLine( const QRectF &, 
+        const QPointF &p1, const QPointF &p2, double &t0, double &t1 );
+
     static QVector<QwtInterval> clipCircle(
         const QRectF &, const QPointF &, double radius );
 };
@@ -0,0 +1,705 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_compressed_point_data.h"
+#include <qmutex.h>
+#include <string.h>
+
+static inline quint64 qwtBits( double value )
+{
+    quint64 bits;
+    ::memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+static inline double qwtDouble( quint64 bits )
+{
+    double value;
+    ::memcpy( &value, &bits, sizeof( value ) );
+
+    return value;
+}
+
+static inline quint64 qwtMask( int numBits )
+{
+    return ( numBits >= 64 ) ? ~quint64( 0 ) : ( quint64( 1 ) << numBits ) - 1;
+}
+
+static inline int qwtLeadingZeros( quint64 value )
+{
+    int n = 0;
+    while ( n < 64 && !( value & ( quint64( 1 ) << ( 63 - n ) ) ) )
+        n++;
+
+    return n;
+}
+
+static inline int qwtTrailingZeros( quint64 value )
+{
+    int n = 0;
+    while ( n < 64 && !( value & ( quint64( 1 ) << n ) ) )
+        n++;
+
+    return n;
+}
+
+static inline bool qwtFitsInto( qint64 value, int numBits )
+{
+    const qint64 limit = qint64( 1 ) << ( numBits - 1 );
+    return ( value >= -limit ) && ( value < limit );
+}
+
+static inline qint64 qwtSignExtended( quint64 value, int numBits )
+{
+    return static_cast<qint64>( value << ( 64 - numBits ) ) >> ( 64 - numBits );
+}
+
+// Writing/reading a stream of bits, starting with the most
+// significant bit of the first word
+
+class QwtBitWriter
+{
+public:
+    QwtBitWriter( QVector<quint64> &words ):
+        d_words( words ),
+        d_numBits( 0 )
+    {
+    }
+
+    inline void write( quint64 value, int numBits )
+    {
+        if ( numBits <= 0 )
+            return;
+
+        value &= qwtMask( numBits );
+
+        const int used = d_numBits % 64;
+        if ( used == 0 )
+            d_words += 0;
+
+        const int available = 64 - used;
+        if ( numBits <= available )
+        {
+            d_words.last() |= value << ( available - numBits );
+        }
+        else
+        {
+            const int rest = numBits - available;
+
+            d_words.last() |= value >> rest;
+            d_words += value << ( 64 - rest );
+        }
+
+        d_numBits += numBits;
+    }
+
+private:
+    QVector<quint64> &d_words;
+    int d_numBits;
+};
+
+class QwtBitReader
+{
+public:
+    QwtBitReader( const quint64 *words ):
+        d_words( words ),
+        d_pos( 0 )
+    {
+    }
+
+    inline quint64 read( int numBits )
+    {
+        if ( numBits <= 0 )
+            return 0;
+
+        const int used = d_pos % 64;
+        const int available = 64 - used;
+
+        const quint64 word = d_words[ d_pos / 64 ] << used;
+
+        quint64 value = word >> ( 64 - numBits );
+        if ( numBits > available )
+        {
+            const int rest = numBits - available;
+            value |= d_words[ d_pos / 64 + 1 ] >> ( 64 - rest );
+        }
+
+        d_pos += numBits;
+        return value;
+    }
+
+    inline bool readBit()
+    {
+        return read( 1 ) != 0;
+    }
+
+private:
+    const quint64 *d_words;
+    int d_pos;
+};
+
+/*
+  The x coordinates: delta of delta of the bit patterns
+  
+    '0'                  : same delta as before
+    '10'   +  7 bits     : difference of the deltas
+    '110'  + 12 bits
+    '1110' + 20 bits
+    '1111' + 64 bits
+
+  The y coordinates: XOR with the previous value
+
+    '0'                  : same value as before
+    '10' + meaningful bits, using the leading/trailing zeros of the previous XOR
+    '11' + 5 bits leading zeros + 6 bits length - 1 + meaningful bits
+ */
+
+static void qwtEncodeBlock( const QPointF *samples, 
+    int count, QVector<quint64> &words )
+{
+    QwtBitWriter writer( words );
+
+    quint64 x = qwtBits( samples[0].x() );
+    quint64 y = qwtBits( samples[0].y() );
+
+    writer.write( x, 64 );
+    writer.write( y, 64 );
+
+    quint64 delta = 0;
+
+    int leading = -1;
+    int trailing = 0;
+
+    for ( int i = 1; i < count; i++ )
+    {
+        const quint64 xi = qwtBits( samples[i].x() );
+        const quint64 deltai = xi - x;
+
+        const qint64 dod = static_cast<qint64>( deltai - delta );
+
+        if ( dod == 0 )
+        {
+            writer.write( 0, 1 );
+        }
+        else if ( qwtFitsInto( dod, 7 ) )
+        {
+            writer.write( 2, 2 );
+            writer.write( dod, 7 );
+        }
+        else if ( qwtFitsInto( dod, 12 ) )
+        {
+            writer.write( 6, 3 );
+            writer.write( dod, 12 );
+        }
+        else if ( qwtFitsInto( dod, 20 ) )
+        {
+            writer.write( 14, 4 );
+            writer.write( dod, 20 );
+        }
+        else
+        {
+            writer.write( 15, 4 );
+            writer.write( dod, 64 );
+        }
+
+        x = xi;
+        delta = deltai;
+
+        const quint64 yi = qwtBits( samples[i].y() );
+        const quint64 xored = yi ^ y;
+
+        if ( xored == 0 )
+        {
+            writer.write( 0, 1 );
+        }
+        else
+        {
+            const int lz = qMin( qwtLeadingZeros( xored ), 31 );
+            const int tz = qwtTrailingZeros( xored );
+
+            if ( leading >= 0 && lz >= leading && tz >= trailing )
+            {
+                writer.write( 2, 2 );
+                writer.write( xored >> trailing, 64 - leading - trailing );
+            }
+            else
+            {
+                const int numBits = 64 - lz - tz;
+
+                writer.write( 3, 2 );
+                writer.write( lz, 5 );
+                writer.write( numBits - 1, 6 );
+                writer.write( xored >> tz, numBits );
+
+                leading = lz;
+                trailing = tz;
+            }
+        }
+
+        y = yi;
+    }
+
+    words.squeeze();
+}
+
+static void qwtDecodeBlock( const QVector<quint64> &words,
+    int count, QPointF *samples )
+{
+    QwtBitReader reader( words.constData() );
+
+    quint64 x = reader.read( 64 );
+    quint64 y = reader.read( 64 );
+
+    samples[0] = QPointF( qwtDouble( x ), qwtDouble( y ) );
+
+    quint64 delta = 0;
+
+    int leading = 0;
+    int trailing = 0;
+
+    for ( int i = 1; i < count; i++ )
+    {
+        if ( reader.readBit() )
+        {
+            int numBits = 64;
+            if ( !reader.readBit() )
+                numBits = 7;
+            else if ( !reader.readBit() )
+                numBits = 12;
+            else if ( !reader.readBit() )
+                numBits = 20;
+
+            quint64 dod = reader.read( numBits );
+            if ( numBits < 64 )
+                dod = static_cast<quint64>( qwtSignExtended( dod, numBits ) );
+
+            delta += dod;
+        }
+
+        x += delta;
+
+        if ( reader.readBit() )
+        {
+            if ( reader.readBit() )
+            {
+                leading = static_cast<int>( reader.read( 5 ) );
+                trailing = 64 - leading - static_cast<int>( reader.read( 6 ) ) - 1;
+            }
+
+            const quint64 xored = 
+                reader.read( 64 - leading - trailing ) << trailing;
+
+            y ^= xored;
+        }
+
+        samples[i] = QPointF( qwtDouble( x ), qwtDouble( y ) );
+    }
+}
+
+class QwtBlockSummary
+{
+public:
+    QwtBlockSummary():
+        isValid( false )
+    {
+    }
+
+    inline void extend( const QPointF &pos )
+    {
+        if ( qIsNaN( pos.x() ) || qIsNaN( pos.y() ) )
+            return;
+
+        if ( isValid )
+        {
+            minX = qMin( minX, pos.x() );
+            maxX = qMax( maxX, pos.x() );
+            minY = qMin( minY, pos.y() );
+            maxY = qMax( maxY, pos.y() );
+        }
+        else
+        {
+            minX = maxX = pos.x();
+            minY = maxY = pos.y();
+
+            isValid = true;
+        }
+    }
+
+    inline void extend( const QwtBlockSummary &other )
+    {
+        if ( !other.isValid )
+            return;
+
+        if ( isValid )
+        {
+            minX = qMin( minX, other.minX );
+            maxX = qMax( maxX, other.maxX );
+            minY = qMin( minY, other.minY );
+            maxY = qMax( maxY, other.maxY );
+        }
+        else
+        {
+            *this = other;
+        }
+    }
+
+    inline QRectF rect() const
+    {
+        if ( !isValid )
+            return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+        QRectF r;
+        r.setCoords( minX, minY, maxX, maxY );
+
+        return r;
+    }
+
+    bool isValid;
+
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+
+class QwtCompressedBlock
+{
+public:
+    QVector<quint64> words;
+    QwtBlockSummary summary;
+};
+
+class QwtDecodedBlock
+{
+public:
+    int index;
+    quint64 lastUsed;
+    QVector<QPointF> samples;
+};
+
+class QwtCompressedPointData::PrivateData
+{
+public:
+    PrivateData():
+        numSamples( 0 ),
+        cacheSize( 8 ),
+        useCount( 0 )
+    {
+        pending.reserve( BlockSize );
+    }
+
+    const QPointF *blockSamples( int index ) const;
+
+    QVector<QwtCompressedBlock> blocks;
+
+    // the last block is not compressed before it is full
+    QVector<QPointF> pending;
+    QwtBlockSummary pendingSummary;
+
+    QwtBlockSummary summary;
+    int numSamples;
+
+    int cacheSize;
+
+    // the mapper might read samples from different threads
+    mutable QMutex mutex;
+
+    mutable QVector<QwtDecodedBlock> cache;
+    mutable quint64 useCount;
+};
+
+// must be called with a locked mutex
+const QPointF *QwtCompressedPointData::PrivateData::blockSamples( int index ) const
+{
+    if ( index == blocks.size() )
+        return pending.constData();
+
+    useCount++;
+
+    int lru = 0;
+    for ( int i = 0; i < cache.size(); i++ )
+    {
+        if ( cache[i].index == index )
+        {
+            cache[i].lastUsed = useCount;
+            return cache[i].samples.constData();
+        }
+
+        if ( cache[i].lastUsed < cache[lru].lastUsed )
+            lru = i;
+    }
+
+    if ( cache.size() < cacheSize )
+    {
+        lru = cache.size();
+        cache.resize( cache.size() + 1 );
+        cache[lru].samples.resize( BlockSize );
+    }
+
+    QwtDecodedBlock &entry = cache[lru];
+    entry.index = index;
+    entry.lastUsed = useCount;
+
+    qwtDecodeBlock( blocks[index].words, BlockSize, entry.samples.data() );
+
+    return entry.samples.constData();
+}
+
+//! Constructor
+QwtCompressedPointData::QwtCompressedPointData()
+{
+    d_data = new PrivateData();
+}
+
+/*!
+  Constructor
+
+  \param samples Initial samples
+ */
+QwtCompressedPointData::QwtCompressedPointData( 
+    const QVector<QPointF> &samples )
+{
+    d_data = new PrivateData();
+    append( samples.constData(), samples.size() );
+}
+
+//! Destructor
+QwtCompressedPointData::~QwtCompressedPointData()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Append a sample
+  \param sample New sample
+ */
+void QwtCompressedPointData::append( const QPointF &sample )
+{
+    append( &sample, 1 );
+}
+
+/*!
+  \brief Append samples
+
+  Each time a block is complete it gets compressed.
+
+  \param samples Array of samples
+  \param count Number of samples
+ */
+void QwtCompressedPointData::append( const QPointF *samples, size_t count )
+{
+    PrivateData *d = d_data;
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const QPointF &sample = samples[i];
+
+        d->pending += sample;
+        d->pendingSummary.extend( sample );
+        d->summary.extend( sample );
+
+        if ( d->pending.size() == BlockSize )
+        {
+            QwtCompressedBlock block;
+            qwtEncodeBlock( d->pending.constData(), BlockSize, block.words );
+            block.summary = d->pendingSummary;
+
+            d->blocks += block;
+
+            d->pending.resize( 0 );
+            d->pendingSummary = QwtBlockSummary();
+        }
+    }
+
+    d->numSamples += static_cast<int>( count );
+}
+
+//! Remove all samples
+void QwtCompressedPointData::clear()
+{
+    PrivateData *d = d_data;
+
+    QMutexLocker locker( &d->mutex );
+
+    d->blocks.clear();
+    d->pending.resize( 0 );
+    d->pendingSummary = QwtBlockSummary();
+    d->summary = QwtBlockSummary();
+    d->numSamples = 0;
+
+    d->cache.clear();
+}
+
+/*!
+  \brief Set the number of decoded blocks, that are cached
+
+  The cache should be large enough for the blocks of the visible
+  range, otherwise they are decoded for each replot. The default
+  setting is 8 blocks.
+
+  \param numBlocks Number of cached blocks, at least 1
+  \sa cacheSize()
+ */
+void QwtCompressedPointData::setCacheSize( int numBlocks )
+{
+    PrivateData *d = d_data;
+
+    QMutexLocker locker( &d->mutex );
+
+    d->cacheSize = qMax( numBlocks, 1 );
+    if ( d->cache.size() > d->cacheSize )
+        d->cache.clear();
+}
+
+/*!
+  \return Number of decoded blocks, that are cached
+  \sa setCacheSize()
+ */
+int QwtCompressedPointData::cacheSize() const
+{
+    return d_data->cacheSize;
+}
+
+/*!
+  \return Number of bytes allocated for the compressed blocks, 
+          the uncompressed last block and the cache
+ */
+size_t QwtCompressedPointData::memoryUsage() const
+{
+    const PrivateData *d = d_data;
+
+    QMutexLocker locker( &d->mutex );
+
+    size_t numBytes = 0;
+
+    for ( int i = 0; i < d->blocks.size(); i++ )
+    {
+        numBytes += sizeof( QwtCompressedBlock ) 
+            + d->blocks[i].words.capacity() * sizeof( quint64 );
+    }
+
+    numBytes += d->pending.capacity() * sizeof( QPointF );
+    numBytes += d->cache.size() * BlockSize * sizeof( QPointF );
+
+    return numBytes;
+}
+
+//! \return Number of samples
+size_t QwtCompressedPointData::size() const
+{
+    return d_data->numSamples;
+}
+
+/*!
+  \return Sample at a specific position
+
+  \param index Index
+ */
+QPointF QwtCompressedPointData::sample( size_t index ) const
+{
+    const PrivateData *d = d_data;
+    const int i = static_cast<int>( index );
+
+    QMutexLocker locker( &d->mutex );
+    return d->blockSamples( i / BlockSize )[ i % BlockSize ];
+}
+
+/*!
+  \brief Copy a range of samples
+
+  \param from Index of the first sample
+  \param count Number of samples
+  \param samples Array, where the samples are copied to
+ */
+void QwtCompressedPointData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    const PrivateData *d = d_data;
+
+    int pos = static_cast<int>( from );
+    int n = static_cast<int>( count );
+
+    QMutexLocker locker( &d->mutex );
+
+    while ( n > 0 )
+    {
+        const int i = pos % BlockSize;
+        const int numSamples = qMin( n, BlockSize - i );
+
+        ::memcpy( samples, d->blockSamples( pos / BlockSize ) + i,
+            numSamples * sizeof( QPointF ) );
+
+        samples += numSamples;
+        pos += numSamples;
+        n -= numSamples;
+    }
+}
+
+/*!
+  \return Bounding rectangle, that is updated, when appending samples
+ */
+QRectF QwtCompressedPointData::boundingRect() const
+{
+    return d_data->summary.rect();
+}
+
+/*!
+  \brief Calculate the bounding rectangle of a range of samples
+
+  The rectangle is calculated from the summaries of all blocks,
+  that are completely inside of the range. Only the blocks at the
+  borders of the range have to be decoded.
+
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param rect Bounding rectangle of the samples
+
+  \return true
+*/
+bool QwtCompressedPointData::rangeBoundingRect( 
+    int from, int to, QRectF &rect ) const
+{
+    const PrivateData *d = d_data;
+
+    from = qMax( from, 0 );
+    to = qMin( to, d->numSamples - 1 );
+
+    QwtBlockSummary s;
+
+    QMutexLocker locker( &d->mutex );
+
+    int pos = from;
+    while ( pos <= to )
+    {
+        const int index = pos / BlockSize;
+        const int i = pos % BlockSize;
+
+        if ( i == 0 && pos + BlockSize - 1 <= to )
+        {
+            // a full block inside of the range
+
+            s.extend( d->blocks[index].summary );
+            pos += BlockSize;
+        }
+        else
+        {
+            const int numSamples = qMin( to - pos + 1, BlockSize - i );
+
+            const QPointF *samples = d->blockSamples( index ) + i;
+            for ( int j = 0; j < numSamples; j++ )
+                s.extend( samples[j] );
+
+            pos += numSamples;
+        }
+    }
+
+    rect = s.rect();
+    return true;
+}
@@ -0,0 +1,79 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_COMPRESSED_POINT_DATA_H
+#define QWT_COMPRESSED_POINT_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+/*!
+  \brief Series of points, that are stored in compressed blocks
+
+  QwtCompressedPointData is intended for long recordings of time series, 
+  where storing 16 bytes for each sample is too expensive. The samples 
+  are compressed losslessly in blocks of BlockSize samples with an 
+  algorithm similar to the one of the Gorilla time series database:
+
+  - The x coordinates are encoded as the difference between
+    consecutive deltas ( "delta of delta" ) of their IEEE 754 bit 
+    patterns. For equidistant timestamps most of them need 1 bit only.
+
+  - The y coordinates are encoded as the XOR with the previous value,
+    storing only the bits between the leading and trailing zeros.
+    Slowly changing signals need a couple of bits only.
+
+  Blocks are decoded, when samples are accessed. The most recently
+  decoded blocks are kept in a cache, so that painting the visible 
+  range decodes the blocks of this range only - and only once, as long 
+  as they fit into the cache. The bounding rectangle of each block 
+  is stored uncompressed, so that bounding rectangles of ranges 
+  don't need to decode more than the blocks at the borders.
+
+  Samples can only be appended. The last block is stored uncompressed,
+  until it is full.
+
+  \sa QwtPointStreamData
+*/
+class QWT_EXPORT QwtCompressedPointData: public QwtSeriesData<QPointF>
+{
+public:
+    //! Number of samples, that are compressed together
+    enum { BlockSize = 1024 };
+
+    QwtCompressedPointData();
+    explicit QwtCompressedPointData( const QVector<QPointF> & );
+    virtual ~QwtCompressedPointData();
+
+    void append( const QPointF & );
+    void append( const QPointF *samples, size_t count );
+
+    void clear();
+
+    void setCacheSize( int numBlocks );
+    int cacheSize() const;
+
+    size_t memoryUsage() const;
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
+
+private:
+    Q_DISABLE_COPY(QwtCompressedPointData)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
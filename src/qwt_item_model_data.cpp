@@ -0,0 +1,465 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_item_model_data.h"
+#include <qabstractitemmodel.h>
+#include <string.h>
+
+class QwtRowSummary
+{
+public:
+    QwtRowSummary():
+        isValid( false )
+    {
+    }
+
+    inline void extend( const QPointF &pos )
+    {
+        if ( qIsNaN( pos.x() ) || qIsNaN( pos.y() ) )
+            return;
+
+        if ( isValid )
+        {
+            minX = qMin( minX, pos.x() );
+            maxX = qMax( maxX, pos.x() );
+            minY = qMin( minY, pos.y() );
+            maxY = qMax( maxY, pos.y() );
+        }
+        else
+        {
+            minX = maxX = pos.x();
+            minY = maxY = pos.y();
+
+            isValid = true;
+        }
+    }
+
+    inline void extend( const QwtRowSummary &other )
+    {
+        if ( !other.isValid )
+            return;
+
+        if ( isValid )
+        {
+            minX = qMin( minX, other.minX );
+            maxX = qMax( maxX, other.maxX );
+            minY = qMin( minY, other.minY );
+            maxY = qMax( maxY, other.maxY );
+        }
+        else
+        {
+            *this = other;
+        }
+    }
+
+    bool isValid;
+
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+
+class QwtItemModelPointData::PrivateData
+{
+public:
+    PrivateData():
+        model( NULL ),
+        xColumn( 0 ),
+        yColumn( 1 ),
+        role( Qt::DisplayRole )
+    {
+    }
+
+    const QAbstractItemModel *model;
+
+    int xColumn;
+    int yColumn;
+    int role;
+
+    QVector<QPointF> samples;
+
+    // chunk i summarizes the rows [ i * ChunkSize, ( i + 1 ) * ChunkSize - 1 ]
+    QVector<QwtRowSummary> chunks;
+};
+
+/*!
+  Constructor
+
+  \param model Model
+  \param xColumn Column of the x values, the row number, when negative
+  \param yColumn Column of the y values
+ */
+QwtItemModelPointData::QwtItemModelPointData( 
+    const QAbstractItemModel *model, int xColumn, int yColumn )
+{
+    d_data = new PrivateData();
+    d_data->xColumn = xColumn;
+    d_data->yColumn = yColumn;
+
+    setModel( model );
+}
+
+//! Destructor
+QwtItemModelPointData::~QwtItemModelPointData()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Assign a model
+
+  All values are read from the model and the adapter
+  starts to track its changes.
+
+  \param model Model
+  \sa model()
+ */
+void QwtItemModelPointData::setModel( const QAbstractItemModel *model )
+{
+    if ( d_data->model )
+        disconnect( d_data->model, NULL, this, NULL );
+
+    d_data->model = model;
+
+    if ( model )
+    {
+        connect( model, SIGNAL( dataChanged( const QModelIndex &, const QModelIndex & ) ),
+            SLOT( updateRows( const QModelIndex &, const QModelIndex & ) ) );
+
+        connect( model, SIGNAL( rowsInserted( const QModelIndex &, int, int ) ),
+            SLOT( insertRows( const QModelIndex &, int, int ) ) );
+        connect( model, SIGNAL( rowsRemoved( const QModelIndex &, int, int ) ),
+            SLOT( removeRows( const QModelIndex &, int, int ) ) );
+
+        // changes, that are too complex to be tracked
+
+        connect( model, SIGNAL( modelReset() ), SLOT( reload() ) );
+        connect( model, SIGNAL( layoutChanged() ), SLOT( reload() ) );
+        connect( model, SIGNAL( rowsMoved( const QModelIndex &, int, int,
+            const QModelIndex &, int ) ), SLOT( reload() ) );
+        connect( model, SIGNAL( columnsInserted( const QModelIndex &, int, int ) ),
+            SLOT( reload() ) );
+        connect( model, SIGNAL( columnsRemoved( const QModelIndex &, int, int ) ),
+            SLOT( reload() ) );
+        connect( model, SIGNAL( columnsMoved( const QModelIndex &, int, int,
+            const QModelIndex &, int ) ), SLOT( reload() ) );
+
+        connect( model, SIGNAL( destroyed() ), SLOT( detachModel() ) );
+    }
+
+    reload();
+}
+
+/*!
+  \return Model
+  \sa setModel()
+ */
+const QAbstractItemModel *QwtItemModelPointData::model() const
+{
+    return d_data->model;
+}
+
+/*!
+  \brief Set the columns of the x and y values
+
+  \param xColumn Column of the x values, the row number, when negative
+  \param yColumn Column of the y values
+
+  \sa xColumn(), yColumn()
+ */
+void QwtItemModelPointData::setColumns( int xColumn, int yColumn )
+{
+    if ( xColumn != d_data->xColumn || yColumn != d_data->yColumn )
+    {
+        d_data->xColumn = xColumn;
+        d_data->yColumn = yColumn;
+
+        reload();
+    }
+}
+
+/*!
+  \return Column of the x values
+  \sa setColumns()
+ */
+int QwtItemModelPointData::xColumn() const
+{
+    return d_data->xColumn;
+}
+
+/*!
+  \return Column of the y values
+  \sa setColumns()
+ */
+int QwtItemModelPointData::yColumn() const
+{
+    return d_data->yColumn;
+}
+
+/*!
+  \brief Set the role of the values 
+
+  \param role Item data role, the default setting is Qt::DisplayRole
+  \sa role()
+ */
+void QwtItemModelPointData::setRole( int role )
+{
+    if ( role != d_data->role )
+    {
+        d_data->role = role;
+        reload();
+    }
+}
+
+/*!
+  \return Item data role of the values
+  \sa setRole()
+ */
+int QwtItemModelPointData::role() const
+{
+    return d_data->role;
+}
+
+//! \return Number of rows
+size_t QwtItemModelPointData::size() const
+{
+    return d_data->samples.size();
+}
+
+/*!
+  \return Sample at a specific position
+
+  \param index Index
+ */
+QPointF QwtItemModelPointData::sample( size_t index ) const
+{
+    return d_data->samples[ static_cast<int>( index ) ];
+}
+
+/*!
+  \brief Copy a range of samples
+
+  \param from Index of the first sample
+  \param count Number of samples
+  \param samples Array, where the samples are copied to
+ */
+void QwtItemModelPointData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    ::memcpy( samples, d_data->samples.constData() + from,
+        count * sizeof( QPointF ) );
+}
+
+/*!
+  \brief Calculate the bounding rectangle
+
+  The rectangle is calculated from the summaries of the chunks.
+
+  \return Bounding rectangle
+*/
+QRectF QwtItemModelPointData::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0.0 )
+    {
+        const QVector<QwtRowSummary> &chunks = d_data->chunks;
+
+        QwtRowSummary s;
+        for ( int i = 0; i < chunks.size(); i++ )
+            s.extend( chunks[i] );
+
+        if ( !s.isValid )
+            return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+        d_boundingRect.setCoords( s.minX, s.minY, s.maxX, s.maxY );
+    }
+
+    return d_boundingRect;
+}
+
+void QwtItemModelPointData::updateRows( 
+    const QModelIndex &topLeft, const QModelIndex &bottomRight )
+{
+    if ( topLeft.parent().isValid() )
+        return;
+
+    const PrivateData *d = d_data;
+
+    const bool hasX = d->xColumn >= topLeft.column() 
+        && d->xColumn <= bottomRight.column();
+
+    const bool hasY = d->yColumn >= topLeft.column() 
+        && d->yColumn <= bottomRight.column();
+
+    if ( !( hasX || hasY ) )
+        return;
+
+    const int from = qMax( topLeft.row(), 0 );
+    const int to = qMin( bottomRight.row(), d->samples.size() - 1 );
+
+    if ( from > to )
+        return;
+
+    QPointF *samples = d_data->samples.data();
+    for ( int row = from; row <= to; row++ )
+        samples[row] = readSample( row );
+
+    updateChunks( from, to );
+
+    Q_EMIT changed();
+}
+
+void QwtItemModelPointData::insertRows( 
+    const QModelIndex &parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    QVector<QPointF> &samples = d_data->samples;
+
+    const int count = last - first + 1;
+    if ( first < 0 || first > samples.size() || count <= 0 )
+    {
+        reload();
+        return;
+    }
+
+    samples.insert( first, count, QPointF() );
+    for ( int row = first; row <= last; row++ )
+        samples[row] = readSample( row );
+
+    // the rows behind the inserted ones have been shifted
+
+    if ( d_data->xColumn < 0 )
+    {
+        for ( int row = last + 1; row < samples.size(); row++ )
+            samples[row].rx() = row;
+    }
+
+    updateChunks( first, samples.size() - 1 );
+
+    Q_EMIT changed();
+}
+
+void QwtItemModelPointData::removeRows( 
+    const QModelIndex &parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    QVector<QPointF> &samples = d_data->samples;
+
+    const int count = last - first + 1;
+    if ( first < 0 || last >= samples.size() || count <= 0 )
+    {
+        reload();
+        return;
+    }
+
+    samples.remove( first, count );
+
+    if ( d_data->xColumn < 0 )
+    {
+        // x is the row number, that has changed for the shifted rows
+
+        for ( int row = first; row < samples.size(); row++ )
+            samples[row].rx() = row;
+    }
+
+    // when removing the last rows, the chunk of the new last 
+    // row might have summarized some of them
+
+    updateChunks( qMin( first, samples.size() - 1 ), samples.size() - 1 );
+
+    Q_EMIT changed();
+}
+
+void QwtItemModelPointData::reload()
+{
+    PrivateData *d = d_data;
+
+    d->samples.clear();
+    d->chunks.clear();
+
+    if ( d->model )
+    {
+        const int numRows = d->model->rowCount();
+
+        d->samples.resize( numRows );
+        for ( int row = 0; row < numRows; row++ )
+            d->samples[row] = readSample( row );
+    }
+
+    updateChunks( 0, d->samples.size() - 1 );
+
+    Q_EMIT changed();
+}
+
+void QwtItemModelPointData::detachModel()
+{
+    d_data->model = NULL;
+    reload();
+}
+
+QPointF QwtItemModelPointData::readSample( int row ) const
+{
+    const PrivateData *d = d_data;
+
+    double values[2];
+
+    const int columns[] = { d->xColumn, d->yColumn };
+    for ( int i = 0; i < 2; i++ )
+    {
+        if ( columns[i] < 0 )
+        {
+            values[i] = row;
+        }
+        else
+        {
+            const QModelIndex index = d->model->index( row, columns[i] );
+
+            bool ok;
+            values[i] = d->model->data( index, d->role ).toDouble( &ok );
+
+            if ( !ok )
+                values[i] = qQNaN();
+        }
+    }
+
+    return QPointF( values[0], values[1] );
+}
+
+void QwtItemModelPointData::updateChunks( int from, int to )
+{
+    PrivateData *d = d_data;
+
+    const int numRows = d->samples.size();
+    d->chunks.resize( ( numRows + ChunkSize - 1 ) / ChunkSize );
+
+    if ( numRows > 0 && from <= to )
+    {
+        const int chunk1 = qMax( from, 0 ) / ChunkSize;
+        const int chunk2 = qMin( to, numRows - 1 ) / ChunkSize;
+
+        const QPointF *samples = d->samples.constData();
+
+        for ( int i = chunk1; i <= chunk2; i++ )
+        {
+            const int end = qMin( ( i + 1 ) * ChunkSize, numRows );
+
+            QwtRowSummary s;
+            for ( int row = i * ChunkSize; row < end; row++ )
+                s.extend( samples[row] );
+
+            d->chunks[i] = s;
+        }
+    }
+
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
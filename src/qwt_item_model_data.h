@@ -0,0 +1,136 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_ITEM_MODEL_DATA_H
+#define QWT_ITEM_MODEL_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include <qobject.h>
+
+class QAbstractItemModel;
+class QModelIndex;
+
+/*!
+  \brief Series of points, that are read from 2 columns of an item model
+
+  QwtItemModelPointData adapts the rows of a table model ( the
+  top level rows of any QAbstractItemModel ) to the QwtSeriesData API.
+  The values of the x and y columns are converted into doubles once 
+  and stored in a contiguous array, so that painting doesn't need
+  to call QAbstractItemModel::data().
+
+  The adapter follows the changes of the model incrementally:
+  inserted, removed or modified rows are read again, but the 
+  values of all other rows are kept. The bounding rectangle is
+  updated from summaries of chunks of ChunkSize rows, without 
+  iterating over all values.
+
+  Values, that can't be converted into a double, are stored as NaN,
+  what excludes them from the bounding rectangle.
+
+  When the x column is negative the row number is taken as x value.
+
+  The curve has to be notified about the changes, as it might
+  keep information about the samples ( f.e. the image of 
+  QwtPlotCurve::CacheCurve or the spatial index ), that 
+  has to be invalidated. A replot of the plot is not sufficient.
+
+  \code
+class Plot: public QwtPlot
+{
+    Q_OBJECT
+
+public:
+    Plot( const QAbstractItemModel *model )
+    {
+        QwtItemModelPointData *data = 
+            new QwtItemModelPointData( model, 0, 2 );
+
+        connect( data, SIGNAL( changed() ), SLOT( updateCurve() ) );
+
+        d_curve = new QwtPlotCurve();
+        d_curve->setData( data );
+        d_curve->attach( this );
+    }
+
+private Q_SLOTS:
+    void updateCurve()
+    {
+        d_curve->dataChanged();
+        replot();
+    }
+
+private:
+    QwtPlotCurve *d_curve;
+};
+  \endcode
+
+  \note As the adapter is deleted by the curve, it must not be 
+        a child of another object.
+*/
+class QWT_EXPORT QwtItemModelPointData: 
+    public QObject, public QwtSeriesData<QPointF>
+{
+    Q_OBJECT
+
+public:
+    //! Number of rows, that are summarized for the bounding rectangle
+    enum { ChunkSize = 256 };
+
+    explicit QwtItemModelPointData( const QAbstractItemModel * = NULL, 
+        int xColumn = 0, int yColumn = 1 );
+
+    virtual ~QwtItemModelPointData();
+
+    void setModel( const QAbstractItemModel * );
+    const QAbstractItemModel *model() const;
+
+    void setColumns( int xColumn, int yColumn );
+    int xColumn() const;
+    int yColumn() const;
+
+    void setRole( int role );
+    int role() const;
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual QRectF boundingRect() const;
+
+Q_SIGNALS:
+    /*!
+      A signal, that is emitted, when the values have been
+      updated from the model.
+
+      \sa QwtPlotCurve::dataChanged()
+     */
+    void changed();
+
+private Q_SLOTS:
+    void updateRows( const QModelIndex &topLeft, 
+        const QModelIndex &bottomRight );
+    void insertRows( const QModelIndex &parent, int first, int last );
+    void removeRows( const QModelIndex &parent, int first, int last );
+    void reload();
+    void detachModel();
+
+private:
+    Q_DISABLE_COPY(QwtItemModelPointData)
+
+    QPointF readSample( int row ) const;
+    void updateChunks( int from, int to );
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
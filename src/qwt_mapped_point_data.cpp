@@ -0,0 +1,670 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_mapped_point_data.h"
+#include "qwt_scale_map.h"
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qdatastream.h>
+#include <qdatetime.h>
+#include <qendian.h>
+#include <limits.h>
+#include <string.h>
+
+static const quint32 qwtIndexMagic = 0x51575449; // "QWTI"
+static const quint32 qwtIndexVersion = 1;
+
+class QwtMappedBlock
+{
+public:
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+
+    qint32 minIndex;
+    qint32 maxIndex;
+};
+
+static inline int qwtPixelColumn( const QwtScaleMap &xMap, double x )
+{
+    // see QwtMinMaxPyramid::levelOfDetail()
+
+    const double pos = qBound( -1.0e9, xMap.transform( x ), 1.0e9 );
+    return qRound( pos );
+}
+
+static inline void qwtAppendIndex( QVector<int> &indices, int index )
+{
+    if ( indices.isEmpty() || indices.last() != index )
+        indices += index;
+}
+
+template <typename Value>
+static void qwtCopyMappedSamples( const Value *values, bool interleaved,
+    qint64 numSamples, qint64 from, qint64 count, QPointF *samples )
+{
+    if ( interleaved )
+    {
+        const Value *v = values + 2 * from;
+        for ( qint64 i = 0; i < count; i++ )
+        {
+            samples[i].rx() = v[0];
+            samples[i].ry() = v[1];
+
+            v += 2;
+        }
+    }
+    else
+    {
+        const Value *x = values + from;
+        const Value *y = values + numSamples + from;
+
+        for ( qint64 i = 0; i < count; i++ )
+        {
+            samples[i].rx() = x[i];
+            samples[i].ry() = y[i];
+        }
+    }
+}
+
+class QwtMappedPointData::PrivateData
+{
+public:
+    PrivateData():
+        values( NULL ),
+        numSamples( 0 ),
+        offset( 0 ),
+        valueType( QwtMappedPointData::Double ),
+        layout( QwtMappedPointData::Interleaved ),
+        boundingRect( 1.0, 1.0, -2.0, -2.0 )
+    {
+    }
+
+    inline QPointF sample( qint64 index ) const
+    {
+        QPointF pos;
+        copySamples( index, 1, &pos );
+
+        return pos;
+    }
+
+    inline void copySamples( qint64 from, qint64 count, QPointF *samples ) const
+    {
+        const bool interleaved = ( layout == QwtMappedPointData::Interleaved );
+
+        if ( valueType == QwtMappedPointData::Double )
+        {
+            qwtCopyMappedSamples( reinterpret_cast<const double *>( values ),
+                interleaved, numSamples, from, count, samples );
+        }
+        else
+        {
+            qwtCopyMappedSamples( reinterpret_cast<const float *>( values ),
+                interleaved, numSamples, from, count, samples );
+        }
+    }
+
+    QFile file;
+    uchar *values;
+
+    qint64 numSamples;
+    qint64 offset;
+
+    QwtMappedPointData::ValueType valueType;
+    QwtMappedPointData::Layout layout;
+
+    QVector<QwtMappedBlock> blocks;
+    QRectF boundingRect;
+
+    QString indexFileName;
+};
+
+//! Constructor
+QwtMappedPointData::QwtMappedPointData()
+{
+    d_data = new PrivateData();
+}
+
+//! Destructor
+QwtMappedPointData::~QwtMappedPointData()
+{
+    close();
+    delete d_data;
+}
+
+/*!
+  \brief Assign a file for storing the summary
+
+  Creating the summary needs to read the complete file once. 
+  When an index file has been assigned the summary is written to it,
+  so that the next open() of the same unmodified file can skip this step.
+
+  The index file is only used, when opening a file. An empty name - 
+  the default - keeps the summary in memory only.
+
+  \param fileName Name of the index file
+  \sa indexFileName(), open(), openRaw()
+ */
+void QwtMappedPointData::setIndexFileName( const QString &fileName )
+{
+    d_data->indexFileName = fileName;
+}
+
+/*!
+  \return Name of the file for storing the summary
+  \sa setIndexFileName()
+ */
+QString QwtMappedPointData::indexFileName() const
+{
+    return d_data->indexFileName;
+}
+
+/*!
+  \brief Open a file with a header
+
+  The file is mapped into memory and the file is read once to
+  create the summary - unless it can be loaded from the index file.
+
+  \param fileName Name of the file
+  \return true, when the file could be opened and mapped
+
+  \sa openRaw(), close()
+ */
+bool QwtMappedPointData::open( const QString &fileName )
+{
+    close();
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    uchar header[32];
+    if ( file.read( reinterpret_cast<char *>( header ), 32 ) != 32 )
+        return false;
+
+    file.close();
+
+    if ( ::memcmp( header, "QWTD", 4 ) != 0 
+        || qFromLittleEndian<quint32>( header + 4 ) != 1 )
+    {
+        return false;
+    }
+
+    const quint32 valueType = qFromLittleEndian<quint32>( header + 8 );
+    const quint32 layout = qFromLittleEndian<quint32>( header + 12 );
+    const quint64 numSamples = qFromLittleEndian<quint64>( header + 16 );
+
+    if ( valueType > Float || layout > Columns )
+        return false;
+
+    return map( fileName, static_cast<ValueType>( valueType ),
+        static_cast<Layout>( layout ), 32, numSamples );
+}
+
+/*!
+  \brief Open a file without a header
+
+  The number of samples is calculated from the size of the file.
+
+  \param fileName Name of the file
+  \param valueType Type of the coordinates
+  \param layout Order of the coordinates
+  \param offset Position of the first coordinate in the file.
+                Should be a multiple of the size of the value type.
+
+  \return true, when the file could be opened and mapped
+  \sa open(), close()
+ */
+bool QwtMappedPointData::openRaw( const QString &fileName,
+    ValueType valueType, Layout layout, qint64 offset )
+{
+    close();
+
+    const qint64 valueSize = ( valueType == Double ) ? 8 : 4;
+    const qint64 numSamples = 
+        ( QFileInfo( fileName ).size() - offset ) / ( 2 * valueSize );
+
+    return map( fileName, valueType, layout, offset, numSamples );
+}
+
+bool QwtMappedPointData::map( const QString &fileName,
+    ValueType valueType, Layout layout, qint64 offset, qint64 numSamples )
+{
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // the values are mapped as they are, without swapping any bytes
+
+    Q_UNUSED( fileName )
+    Q_UNUSED( valueType )
+    Q_UNUSED( layout )
+    Q_UNUSED( offset )
+    Q_UNUSED( numSamples )
+
+    return false;
+#else
+
+    if ( numSamples < 0 || numSamples > INT_MAX )
+        return false;
+
+    PrivateData *d = d_data;
+
+    d->file.setFileName( fileName );
+    if ( !d->file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 valueSize = ( valueType == Double ) ? 8 : 4;
+    const qint64 numBytes = numSamples * 2 * valueSize;
+
+    if ( offset < 0 || offset + numBytes > d->file.size() )
+    {
+        d->file.close();
+        return false;
+    }
+
+    if ( numBytes > 0 )
+    {
+        d->values = d->file.map( offset, numBytes );
+        if ( d->values == NULL )
+        {
+            d->file.close();
+            return false;
+        }
+    }
+
+    d->numSamples = numSamples;
+    d->offset = offset;
+    d->valueType = valueType;
+    d->layout = layout;
+
+    loadSummary();
+
+    return true;
+#endif
+}
+
+/*!
+  \brief Unmap and close the file
+  \sa open(), openRaw()
+ */
+void QwtMappedPointData::close()
+{
+    PrivateData *d = d_data;
+
+    if ( d->values )
+    {
+        d->file.unmap( d->values );
+        d->values = NULL;
+    }
+
+    d->file.close();
+
+    d->numSamples = 0;
+    d->offset = 0;
+    d->blocks.clear();
+    d->boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 );
+}
+
+//! \return true, when a file is mapped
+bool QwtMappedPointData::isOpen() const
+{
+    return d_data->file.isOpen();
+}
+
+//! \return Name of the mapped file
+QString QwtMappedPointData::fileName() const
+{
+    return d_data->file.fileName();
+}
+
+//! \return Type of the coordinates in the file
+QwtMappedPointData::ValueType QwtMappedPointData::valueType() const
+{
+    return d_data->valueType;
+}
+
+//! \return Order of the coordinates in the file
+QwtMappedPointData::Layout QwtMappedPointData::layout() const
+{
+    return d_data->layout;
+}
+
+void QwtMappedPointData::loadSummary()
+{
+    PrivateData *d = d_data;
+
+    const int numBlocks = 
+        static_cast<int>( ( d->numSamples + BlockSize - 1 ) / BlockSize );
+
+    if ( !readSummary( numBlocks ) )
+    {
+        // reading all samples once
+
+        d->blocks.resize( numBlocks );
+
+        QPointF samples[ BlockSize ];
+        for ( int i = 0; i < numBlocks; i++ )
+        {
+            const qint64 from = qint64( i ) * BlockSize;
+            const int count = static_cast<int>( 
+                qMin( qint64( BlockSize ), d->numSamples - from ) );
+
+            d->copySamples( from, count, samples );
+
+            QwtMappedBlock &b = d->blocks[i];
+            b.minX = b.maxX = samples[0].x();
+            b.minY = b.maxY = samples[0].y();
+            b.minIndex = b.maxIndex = static_cast<qint32>( from );
+
+            for ( int j = 1; j < count; j++ )
+            {
+                const QPointF &pos = samples[j];
+
+                if ( pos.x() < b.minX )
+                    b.minX = pos.x();
+                if ( pos.x() > b.maxX )
+                    b.maxX = pos.x();
+
+                if ( pos.y() < b.minY )
+                {
+                    b.minY = pos.y();
+                    b.minIndex = static_cast<qint32>( from + j );
+                }
+                if ( pos.y() > b.maxY )
+                {
+                    b.maxY = pos.y();
+                    b.maxIndex = static_cast<qint32>( from + j );
+                }
+            }
+        }
+
+        writeSummary();
+    }
+
+    if ( numBlocks > 0 )
+    {
+        const QwtMappedBlock &b0 = d->blocks[0];
+
+        double minX = b0.minX;
+        double maxX = b0.maxX;
+        double minY = b0.minY;
+        double maxY = b0.maxY;
+
+        for ( int i = 1; i < numBlocks; i++ )
+        {
+            const QwtMappedBlock &b = d->blocks[i];
+
+            minX = qMin( minX, b.minX );
+            maxX = qMax( maxX, b.maxX );
+            minY = qMin( minY, b.minY );
+            maxY = qMax( maxY, b.maxY );
+        }
+
+        d->boundingRect.setCoords( minX, minY, maxX, maxY );
+    }
+}
+
+bool QwtMappedPointData::readSummary( int numBlocks )
+{
+    PrivateData *d = d_data;
+
+    if ( d->indexFileName.isEmpty() )
+        return false;
+
+    QFile indexFile( d->indexFileName );
+    if ( !indexFile.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const QFileInfo info( d->file.fileName() );
+
+    QDataStream stream( &indexFile );
+    stream.setVersion( QDataStream::Qt_4_0 );
+
+    quint32 magic, version, blockSize, valueType, layout;
+    qint64 numSamples, offset, fileSize;
+    QString filePath;
+    QDateTime lastModified;
+    qint32 count;
+
+    stream >> magic >> version >> blockSize >> valueType >> layout
+        >> numSamples >> offset >> filePath >> fileSize 
+        >> lastModified >> count;
+
+    if ( stream.status() != QDataStream::Ok
+        || magic != qwtIndexMagic || version != qwtIndexVersion
+        || blockSize != BlockSize || valueType != quint32( d->valueType )
+        || layout != quint32( d->layout ) || numSamples != d->numSamples
+        || offset != d->offset || filePath != info.absoluteFilePath()
+        || fileSize != info.size() || lastModified != info.lastModified() 
+        || count != numBlocks )
+    {
+        return false;
+    }
+
+    d->blocks.resize( numBlocks );
+    for ( int i = 0; i < numBlocks; i++ )
+    {
+        QwtMappedBlock &b = d->blocks[i];
+        stream >> b.minX >> b.maxX >> b.minY >> b.maxY
+            >> b.minIndex >> b.maxIndex;
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+    {
+        d->blocks.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void QwtMappedPointData::writeSummary() const
+{
+    const PrivateData *d = d_data;
+
+    if ( d->indexFileName.isEmpty() )
+        return;
+
+    // the index is an optimization only: failing to
+    // write it is not an error
+
+    QFile indexFile( d->indexFileName );
+    if ( !indexFile.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return;
+
+    const QFileInfo info( d->file.fileName() );
+
+    QDataStream stream( &indexFile );
+    stream.setVersion( QDataStream::Qt_4_0 );
+
+    stream << qwtIndexMagic << qwtIndexVersion 
+        << quint32( BlockSize ) << quint32( d->valueType )
+        << quint32( d->layout ) << qint64( d->numSamples ) 
+        << qint64( d->offset ) << info.absoluteFilePath()
+        << qint64( info.size() ) << info.lastModified() 
+        << qint32( d->blocks.size() );
+
+    for ( int i = 0; i < d->blocks.size(); i++ )
+    {
+        const QwtMappedBlock &b = d->blocks[i];
+        stream << b.minX << b.maxX << b.minY << b.maxY
+            << b.minIndex << b.maxIndex;
+    }
+}
+
+//! \return Number of samples
+size_t QwtMappedPointData::size() const
+{
+    return static_cast<size_t>( d_data->numSamples );
+}
+
+/*!
+  \return Sample at a specific position
+
+  \param index Index
+ */
+QPointF QwtMappedPointData::sample( size_t index ) const
+{
+    return d_data->sample( static_cast<qint64>( index ) );
+}
+
+/*!
+  \brief Copy a range of samples
+
+  \param from Index of the first sample
+  \param count Number of samples
+  \param samples Array, where the samples are copied to
+ */
+void QwtMappedPointData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    d_data->copySamples( static_cast<qint64>( from ),
+        static_cast<qint64>( count ), samples );
+}
+
+/*!
+  \return Bounding rectangle, calculated from the summary
+ */
+QRectF QwtMappedPointData::boundingRect() const
+{
+    return d_data->boundingRect;
+}
+
+void QwtMappedPointData::yExtrema( int from, int to, 
+    int &minIndex, int &maxIndex ) const
+{
+    const PrivateData *d = d_data;
+
+    minIndex = maxIndex = from;
+
+    double minY = d->sample( from ).y();
+    double maxY = minY;
+
+    int i = from + 1;
+    while ( i <= to )
+    {
+        if ( ( i % BlockSize ) == 0 && i + BlockSize - 1 <= to )
+        {
+            const QwtMappedBlock &b = d->blocks[ i / BlockSize ];
+
+            if ( b.minY < minY )
+            {
+                minY = b.minY;
+                minIndex = b.minIndex;
+            }
+
+            if ( b.maxY > maxY )
+            {
+                maxY = b.maxY;
+                maxIndex = b.maxIndex;
+            }
+
+            i += BlockSize;
+        }
+        else
+        {
+            const double y = d->sample( i ).y();
+
+            if ( y < minY )
+            {
+                minY = y;
+                minIndex = i;
+            }
+
+            if ( y > maxY )
+            {
+                maxY = y;
+                maxIndex = i;
+            }
+
+            i++;
+        }
+    }
+}
+
+/*!
+  \brief Reduce a range of samples to the relevant samples for each pixel column
+
+  The same algorithm as QwtMinMaxPyramid::levelOfDetail(), but the
+  extrema are taken from the summary of blocks. Only the samples
+  at the borders of the pixel columns are read from the file.
+
+  \param xMap Maps x-values into pixel coordinates
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param indices Indices of the reduced samples in increasing order
+
+  \return false, when there is nothing to reduce
+ */
+bool QwtMappedPointData::levelOfDetail( const QwtScaleMap &xMap,
+    int from, int to, QVector<int> &indices ) const
+{
+    const PrivateData *d = d_data;
+
+    if ( from < 0 || from > to || to >= d->numSamples )
+        return false;
+
+    const int c1 = qwtPixelColumn( xMap, d->sample( from ).x() );
+    const int c2 = qwtPixelColumn( xMap, d->sample( to ).x() );
+
+    const qint64 numColumns = qAbs( qint64( c2 ) - qint64( c1 ) ) + 1;
+    if ( to - from + 1 <= 4 * numColumns )
+        return false;
+
+    indices.clear();
+    indices.reserve( 4 * static_cast<int>( numColumns ) );
+
+    int i = from;
+    while ( i <= to )
+    {
+        const int column = qwtPixelColumn( xMap, d->sample( i ).x() );
+
+        int lo = i;
+        int hi = to + 1;
+
+        for ( int step = 1; lo + step <= to; step *= 2 )
+        {
+            if ( qwtPixelColumn( xMap, d->sample( lo + step ).x() ) != column )
+            {
+                hi = lo + step;
+                break;
+            }
+
+            lo += step;
+        }
+
+        while ( hi - lo > 1 )
+        {
+            const int mid = lo + ( hi - lo ) / 2;
+
+            if ( qwtPixelColumn( xMap, d->sample( mid ).x() ) == column )
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        qwtAppendIndex( indices, i );
+
+        if ( lo > i )
+        {
+            int minIndex, maxIndex;
+            yExtrema( i, lo, minIndex, maxIndex );
+
+            if ( minIndex > maxIndex )
+                qSwap( minIndex, maxIndex );
+
+            qwtAppendIndex( indices, minIndex );
+            qwtAppendIndex( indices, maxIndex );
+            qwtAppendIndex( indices, lo );
+        }
+
+        i = lo + 1;
+    }
+
+    return true;
+}
@@ -0,0 +1,122 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MAPPED_POINT_DATA_H
+#define QWT_MAPPED_POINT_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QString;
+
+/*!
+  \brief Series of points, that are mapped from a file into memory
+
+  QwtMappedPointData gives access to the samples of a file
+  without loading it: the file is mapped into the address space
+  ( QFile::map() ) and the operating system reads the pages, 
+  when they are accessed. As long as only a part of the series is
+  visible ( see QwtPlotCurve::SortedSamples ) only this part is read.
+
+  The bounding rectangle and the extrema needed for 
+  levelOfDetail() are taken from a summary of blocks of BlockSize samples,
+  that is created by reading the file once. By default the summary
+  is kept in memory only. When an index file has been assigned
+  ( setIndexFileName() ) the summary is stored there and reused
+  as long as the name, the size and the modification time of the 
+  file don't change.
+
+  The file has the following format, all values in little endian byte order:
+
+  - A header of 32 bytes
+    - 4 bytes: the characters "QWTD"
+    - quint32: version, always 1
+    - quint32: value type: 0 = double, 1 = float
+    - quint32: layout: 0 = interleaved ( x0, y0, x1, y1, ... ), 
+               1 = columns ( x0, x1, ..., y0, y1, ... )
+    - quint64: number of samples
+    - quint64: reserved, always 0
+  - The x and y coordinates according to value type and layout
+
+  Files without a header can be opened with openRaw().
+
+  levelOfDetail() expects the x coordinates to be increasing.
+
+  \note As QwtPlotCurve addresses samples by int the number of 
+        samples is limited to INT_MAX.
+*/
+class QWT_EXPORT QwtMappedPointData: public QwtSeriesData<QPointF>
+{
+public:
+    //! Number of samples, that are summarized by an entry of the summary
+    enum { BlockSize = 1024 };
+
+    //! Type of the coordinates in the file
+    enum ValueType
+    {
+        //! 64 bit IEEE 754
+        Double,
+
+        //! 32 bit IEEE 754
+        Float
+    };
+
+    //! Order of the coordinates in the file
+    enum Layout
+    {
+        //! x0, y0, x1, y1, ...
+        Interleaved,
+
+        //! x0, x1, ..., y0, y1, ...
+        Columns
+    };
+
+    QwtMappedPointData();
+    virtual ~QwtMappedPointData();
+
+    void setIndexFileName( const QString & );
+    QString indexFileName() const;
+
+    bool open( const QString &fileName );
+    bool openRaw( const QString &fileName, 
+        ValueType, Layout, qint64 offset = 0 );
+
+    void close();
+    bool isOpen() const;
+
+    QString fileName() const;
+    ValueType valueType() const;
+    Layout layout() const;
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual QRectF boundingRect() const;
+
+    virtual bool levelOfDetail( const QwtScaleMap &xMap,
+        int from, int to, QVector<int> &indices ) const;
+
+private:
+    Q_DISABLE_COPY(QwtMappedPointData)
+
+    bool map( const QString &fileName, 
+        ValueType, Layout, qint64 offset, qint64 numSamples );
+
+    void loadSummary();
+    bool readSummary( int numBlocks );
+    void writeSummary() const;
+    void yExtrema( int from, int to, int &minIndex, int &maxIndex ) const;
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
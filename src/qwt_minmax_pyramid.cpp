@@ -0,0 +1,338 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_minmax_pyramid.h"
+#include "qwt_scale_map.h"
+
+class QwtMinMaxEntry
+{
+public:
+    int minIndex;
+    int maxIndex;
+};
+
+static inline int qwtPixelColumn( const QwtScaleMap &xMap, double x )
+{
+    // limiting the value avoids integer overflows for points far
+    // outside of the canvas. As all of them end up in the same column
+    // the reduced polyline stays outside as well.
+
+    const double pos = qBound( -1.0e9, xMap.transform( x ), 1.0e9 );
+    return qRound( pos );
+}
+
+static inline void qwtAppendIndex( QVector<int> &indices, int index )
+{
+    if ( indices.isEmpty() || indices.last() != index )
+        indices += index;
+}
+
+class QwtMinMaxPyramid::PrivateData
+{
+public:
+    PrivateData():
+        numSamples( 0 )
+    {
+    }
+
+    size_t numSamples;
+    QVector< QVector<QwtMinMaxEntry> > levels;
+};
+
+/*!
+  \brief Constructor
+
+  The pyramid is empty until build() has been called.
+ */
+QwtMinMaxPyramid::QwtMinMaxPyramid()
+{
+    d_data = new PrivateData();
+}
+
+//! Destructor
+QwtMinMaxPyramid::~QwtMinMaxPyramid()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Build the index for a series
+
+  All samples of the series are read once. Building the index
+  for a series with n samples needs memory for 2 * n / BlockSize
+  pairs of integers.
+
+  \param series Series
+  \sa reset()
+ */
+void QwtMinMaxPyramid::build( const QwtSeriesData<QPointF> &series )
+{
+    reset();
+
+    const size_t numSamples = series.size();
+    const int numBlocks = static_cast<int>( numSamples / BlockSize );
+
+    d_data->numSamples = numSamples;
+
+    if ( numBlocks == 0 )
+        return;
+
+    QVector<QwtMinMaxEntry> level( numBlocks );
+
+    for ( int i = 0; i < numBlocks; i++ )
+    {
+        const int from = i * BlockSize;
+
+        QwtMinMaxEntry &entry = level[i];
+        entry.minIndex = entry.maxIndex = from;
+
+        double minY = series.sample( from ).y();
+        double maxY = minY;
+
+        for ( int j = from + 1; j < from + BlockSize; j++ )
+        {
+            const double y = series.sample( j ).y();
+            if ( y < minY )
+            {
+                minY = y;
+                entry.minIndex = j;
+            }
+            else if ( y > maxY )
+            {
+                maxY = y;
+                entry.maxIndex = j;
+            }
+        }
+    }
+
+    d_data->levels += level;
+
+    while ( level.size() >= 2 )
+    {
+        QVector<QwtMinMaxEntry> upper( level.size() / 2 );
+
+        for ( int i = 0; i < upper.size(); i++ )
+        {
+            const QwtMinMaxEntry &e1 = level[2 * i];
+            const QwtMinMaxEntry &e2 = level[2 * i + 1];
+
+            QwtMinMaxEntry &entry = upper[i];
+
+            entry.minIndex = e1.minIndex;
+            if ( series.sample( e2.minIndex ).y() < series.sample( e1.minIndex ).y() )
+                entry.minIndex = e2.minIndex;
+
+            entry.maxIndex = e1.maxIndex;
+            if ( series.sample( e2.maxIndex ).y() > series.sample( e1.maxIndex ).y() )
+                entry.maxIndex = e2.maxIndex;
+        }
+
+        d_data->levels += upper;
+        level = upper;
+    }
+}
+
+/*!
+  \brief Clear the index
+  \sa build()
+ */
+void QwtMinMaxPyramid::reset()
+{
+    d_data->numSamples = 0;
+    d_data->levels.clear();
+}
+
+/*!
+  \return Number of samples of the series, the index has been built for
+  \sa build()
+ */
+size_t QwtMinMaxPyramid::size() const
+{
+    return d_data->numSamples;
+}
+
+//! \return Number of levels
+int QwtMinMaxPyramid::numLevels() const
+{
+    return d_data->levels.size();
+}
+
+/*!
+  \brief Find the samples with the minimum and maximum y values
+
+  \param series Series, the index has been built for
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param minIndex Index of the sample with the minimum y value
+  \param maxIndex Index of the sample with the maximum y value
+
+  \return false, when the range is invalid or the index doesn't match the series
+ */
+bool QwtMinMaxPyramid::yExtrema( const QwtSeriesData<QPointF> &series,
+    int from, int to, int &minIndex, int &maxIndex ) const
+{
+    const QVector< QVector<QwtMinMaxEntry> > &levels = d_data->levels;
+
+    if ( series.size() != d_data->numSamples || from < 0
+        || from > to || static_cast<size_t>( to ) >= d_data->numSamples )
+    {
+        return false;
+    }
+
+    minIndex = maxIndex = from;
+
+    double minY = series.sample( from ).y();
+    double maxY = minY;
+
+    int i = from + 1;
+    while ( i <= to )
+    {
+        int iMin, iMax, count;
+
+        if ( ( i % BlockSize ) == 0 && i + BlockSize - 1 <= to )
+        {
+            // the largest aligned block, that fits into the range
+
+            int level = 0;
+            int blockSize = BlockSize;
+
+            while ( level + 1 < levels.size()
+                && ( i % ( 2 * blockSize ) ) == 0
+                && i + 2 * blockSize - 1 <= to )
+            {
+                level++;
+                blockSize *= 2;
+            }
+
+            const QwtMinMaxEntry &entry = levels[level][i / blockSize];
+
+            iMin = entry.minIndex;
+            iMax = entry.maxIndex;
+            count = blockSize;
+        }
+        else
+        {
+            iMin = iMax = i;
+            count = 1;
+        }
+
+        const double y1 = series.sample( iMin ).y();
+        if ( y1 < minY )
+        {
+            minY = y1;
+            minIndex = iMin;
+        }
+
+        const double y2 = ( iMax == iMin ) ? y1 : series.sample( iMax ).y();
+        if ( y2 > maxY )
+        {
+            maxY = y2;
+            maxIndex = iMax;
+        }
+
+        i += count;
+    }
+
+    return true;
+}
+
+/*!
+  \brief Reduce a range of samples to the relevant samples for each pixel column
+
+  The samples are grouped by the pixel column, their x coordinates
+  are mapped to. Each group is reduced to its first and last sample
+  and the samples with the minimum and maximum y values in between.
+
+  The pixel columns are calculated in the same way as QwtPointMapper rounds
+  the positions, when painting to a device with integer coordinates.
+  A polyline through the reduced samples is identical to a polyline
+  through all samples then.
+
+  \param series Series, the index has been built for
+  \param xMap Maps x-values into pixel coordinates
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param indices Indices of the reduced samples in increasing order
+
+  \return false, when there is nothing to reduce or the index doesn't match the series
+ */
+bool QwtMinMaxPyramid::levelOfDetail( const QwtSeriesData<QPointF> &series,
+    const QwtScaleMap &xMap, int from, int to, QVector<int> &indices ) const
+{
+    if ( series.size() != d_data->numSamples || from < 0
+        || from > to || static_cast<size_t>( to ) >= d_data->numSamples )
+    {
+        return false;
+    }
+
+    const int c1 = qwtPixelColumn( xMap, series.sample( from ).x() );
+    const int c2 = qwtPixelColumn( xMap, series.sample( to ).x() );
+
+    const qint64 numColumns = qAbs( qint64( c2 ) - qint64( c1 ) ) + 1;
+    if ( to - from + 1 <= 4 * numColumns )
+        return false;
+
+    indices.clear();
+    indices.reserve( 4 * static_cast<int>( numColumns ) );
+
+    int i = from;
+    while ( i <= to )
+    {
+        const int column = qwtPixelColumn( xMap, series.sample( i ).x() );
+
+        /*
+          As the x coordinates are monotonic we can find the
+          last sample of the column by an exponential search,
+          followed by a binary search.
+         */
+
+        int lo = i;
+        int hi = to + 1;
+
+        for ( int step = 1; lo + step <= to; step *= 2 )
+        {
+            if ( qwtPixelColumn( xMap, series.sample( lo + step ).x() ) != column )
+            {
+                hi = lo + step;
+                break;
+            }
+
+            lo += step;
+        }
+
+        while ( hi - lo > 1 )
+        {
+            const int mid = lo + ( hi - lo ) / 2;
+
+            if ( qwtPixelColumn( xMap, series.sample( mid ).x() ) == column )
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        qwtAppendIndex( indices, i );
+
+        if ( lo > i )
+        {
+            int minIndex, maxIndex;
+            yExtrema( series, i, lo, minIndex, maxIndex );
+
+            if ( minIndex > maxIndex )
+                qSwap( minIndex, maxIndex );
+
+            qwtAppendIndex( indices, minIndex );
+            qwtAppendIndex( indices, maxIndex );
+            qwtAppendIndex( indices, lo );
+        }
+
+        i = lo + 1;
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_MINMAX_PYRAMID_H
+#define QWT_MINMAX_PYRAMID_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtScaleMap;
+
+/*!
+  \brief A multi resolution index of the y extrema of a series
+
+  QwtMinMaxPyramid stores the positions of the minimum and maximum
+  y values for blocks of BlockSize samples. Each following level
+  summarizes 2 blocks of the previous one, so that the extrema
+  of any range of samples can be found in O(log(n)).
+
+  levelOfDetail() uses the index to reduce the samples of a series,
+  that are mapped to the same pixel column, to the first, last, minimum
+  and maximum sample ( "M4" ). A polyline through the reduced samples
+  covers the same pixels as a polyline through all of them, but the
+  costs for finding them depend on the number of pixel columns only.
+
+  The x coordinates of the series have to be monotonic.
+
+  The index itself stores 2 integers for each block of samples,
+  the series needs to be passed to all methods, that have to
+  read values.
+
+  \sa QwtPointPyramidData
+ */
+class QWT_EXPORT QwtMinMaxPyramid
+{
+public:
+    //! Number of samples, that are summarized by an entry of the lowest level
+    enum { BlockSize = 16 };
+
+    QwtMinMaxPyramid();
+    ~QwtMinMaxPyramid();
+
+    void build( const QwtSeriesData<QPointF> &series );
+    void reset();
+
+    size_t size() const;
+    int numLevels() const;
+
+    bool yExtrema( const QwtSeriesData<QPointF> &series,
+        int from, int to, int &minIndex, int &maxIndex ) const;
+
+    bool levelOfDetail( const QwtSeriesData<QPointF> &series,
+        const QwtScaleMap &xMap, int from, int to,
+        QVector<int> &indices ) const;
+
+private:
+    Q_DISABLE_COPY(QwtMinMaxPyramid)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -188,6 +188,9 @@ public:
     void setAxisAutoScale( int axisId, bool on = true );
     bool axisAutoScale( int axisId ) const;
 
+    void setAxisAutoScaleToVisibleRange( int axisId, bool on = true );
+    bool axisAutoScaleToVisibleRange( int axisId ) const;
+
     void enableAxis( int axisId, bool tf = true );
     bool axisEnabled( int axisId ) const;
 
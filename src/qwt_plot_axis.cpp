@@ -18,6 +18,7 @@ class QwtPlot::AxisData
 public:
     bool isEnabled;
     bool doAutoScale;
+    bool autoScaleToVisibleRange;
 
     double minValue;
     double maxValue;
@@ -78,6 +79,7 @@ void QwtPlot::initAxesData()
         d.scaleWidget->setTitle( text );
 
         d.doAutoScale = true;
+        d.autoScaleToVisibleRange = false;
 
         d.minValue = 0.0;
         d.maxValue = 1000.0;
@@ -191,6 +193,19 @@ bool QwtPlot::axisAutoScale( int axisId ) const
         return false;
 }
 
+/*!
+  \return \c True, if autoscaling is limited to the visible range of the x axis
+  \param axisId Axis index
+  \sa setAxisAutoScaleToVisibleRange()
+*/
+bool QwtPlot::axisAutoScaleToVisibleRange( int axisId ) const
+{
+    if ( axisValid( axisId ) )
+        return d_axisData[axisId]->autoScaleToVisibleRange;
+    else
+        return false;
+}
+
 /*!
   \return \c True, if a specified axis is enabled
   \param axisId Axis index
@@ -429,6 +444,31 @@ void QwtPlot::setAxisAutoScale( int axisId, bool on )
     }
 }
 
+/*!
+  \brief Autoscale a y axis to the samples inside of the visible x range
+
+  When enabled, the boundaries of an autoscaled y axis are calculated
+  from the parts of the items, that are inside of the current scale of
+  their x axis ( QwtPlotItem::boundingRectInXRange() ). This is 
+  useful for scrolling through long series with a fixed x scale.
+
+  The mode has no effect for x axes, or for items, where the x axis 
+  is autoscaled too.
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisAutoScaleToVisibleRange(), setAxisAutoScale(), updateAxes()
+*/
+void QwtPlot::setAxisAutoScaleToVisibleRange( int axisId, bool on )
+{
+    if ( axisValid( axisId ) && 
+        ( d_axisData[axisId]->autoScaleToVisibleRange != on ) )
+    {
+        d_axisData[axisId]->autoScaleToVisibleRange = on;
+        autoRefresh();
+    }
+}
+
 /*!
   \brief Disable autoscaling and specify a fixed scale for a selected axis.
 
@@ -632,9 +672,13 @@ void QwtPlot::setAxisTitle( int axisId, const QwtText &title )
   The scale widget indicates modifications by emitting a 
   QwtScaleWidget::scaleDivChanged() signal.
 
+  y axes, that are autoscaled to the visible range of the x axis, are
+  calculated from QwtPlotItem::boundingRectInXRange() instead.
+
   updateAxes() is usually called by replot(). 
 
-  \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
+  \sa setAxisAutoScale(), setAxisAutoScaleToVisibleRange(), setAxisScale(),
+      setAxisScaleDiv(), replot()
       QwtPlotItem::boundingRect()
  */
 void QwtPlot::updateAxes()
@@ -659,11 +703,24 @@ void QwtPlot::updateAxes()
 
         if ( axisAutoScale( item->xAxis() ) || axisAutoScale( item->yAxis() ) )
         {
-            const QRectF rect = item->boundingRect();
+            QRectF rect = item->boundingRect();
 
             if ( rect.width() >= 0.0 )
                 intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
 
+            const AxisData &xData = *d_axisData[item->xAxis()];
+            const AxisData &yData = *d_axisData[item->yAxis()];
+
+            if ( yData.doAutoScale && yData.autoScaleToVisibleRange 
+                && !xData.doAutoScale )
+            {
+                const QwtInterval xInterval = xData.isValid 
+                    ? xData.scaleDiv.interval()
+                    : QwtInterval( xData.minValue, xData.maxValue );
+
+                rect = item->boundingRectInXRange( xInterval.normalized() );
+            }
+
             if ( rect.height() >= 0.0 )
                 intv[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
         }
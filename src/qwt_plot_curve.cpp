@@ -17,8 +17,13 @@
 #include "qwt_spline_curve_fitter.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
+#include "qwt_spatial_index.h"
+#include "qwt_point_stream_data.h"
+#include "qwt_shared_column_data.h"
 #include <qpainter.h>
+#include <qpaintengine.h>
 #include <qpixmap.h>
+#include <qimage.h>
 #include <qalgorithms.h>
 #include <qmath.h>
 
@@ -38,6 +43,40 @@ static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *paint
     return clipRect;
 }
 
+/*
+  A view on selected samples of a series, used to paint the samples
+  found by QwtSeriesData::levelOfDetail()
+ */
+class QwtIndexedPointData: public QwtSeriesData<QPointF>
+{
+public:
+    QwtIndexedPointData( const QwtSeriesData<QPointF> *series,
+            const QVector<int> &indices ):
+        d_series( series ),
+        d_indices( indices )
+    {
+    }
+
+    virtual size_t size() const
+    {
+        return d_indices.size();
+    }
+
+    virtual QPointF sample( size_t i ) const
+    {
+        return d_series->sample( d_indices[ static_cast<int>( i ) ] );
+    }
+
+    virtual QRectF boundingRect() const
+    {
+        return d_series->boundingRect();
+    }
+
+private:
+    const QwtSeriesData<QPointF> *d_series;
+    const QVector<int> d_indices;
+};
+
 static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
 {
     if ( curve->symbol() && 
@@ -75,6 +114,104 @@ static int qwtVerifyRange( int size, int &i1, int &i2 )
     return ( i2 - i1 + 1 );
 }
 
+class QwtCompareX
+{
+public:
+    QwtCompareX( bool ascending, bool inclusive ):
+        d_ascending( ascending ),
+        d_inclusive( inclusive )
+    {
+    }
+
+    inline bool operator()( const double x, const QPointF &pos ) const
+    {
+        if ( d_ascending )
+            return d_inclusive ? ( x <= pos.x() ) : ( x < pos.x() );
+
+        return d_inclusive ? ( x >= pos.x() ) : ( x > pos.x() );
+    }
+
+private:
+    const bool d_ascending;
+    const bool d_inclusive;
+};
+
+static void qwtVisibleRange( const QwtSeriesData<QPointF> &series,
+    double x1, double x2, int &from, int &to )
+{
+    const int numSamples = static_cast<int>( series.size() );
+
+    const bool ascending = 
+        series.sample( 0 ).x() <= series.sample( numSamples - 1 ).x();
+
+    if ( !ascending )
+        qSwap( x1, x2 );
+
+    // the first sample, that is not in front of the interval
+
+    int index1 = qwtUpperSampleIndex<QPointF>( 
+        series, x1, QwtCompareX( ascending, true ) );
+    if ( index1 < 0 )
+        index1 = numSamples;
+
+    // the first sample behind the interval
+
+    int index2 = qwtUpperSampleIndex<QPointF>( 
+        series, x2, QwtCompareX( ascending, false ) );
+    if ( index2 < 0 )
+        index2 = numSamples - 1;
+
+    // one sample of padding on each side
+
+    from = qMax( from, index1 - 1 );
+    to = qMin( to, index2 );
+}
+
+static bool qwtCanCache( QPainter *painter )
+{
+    // when the paint device is aligning it is not one
+    // where scalability matters ( PDF, SVG ).
+
+    if ( !QwtPainter::roundingAlignment( painter ) )
+        return false;
+
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Picture:
+        case QPaintEngine::User: // usually QwtGraphic
+        {
+            // don't use a cache for record/replay devices
+            return false;
+        }
+        default:;
+    }
+
+    return true;
+}
+
+class QwtCurveCache
+{
+public:
+    QwtCurveCache():
+        from( 0 ),
+        to( -1 ),
+        paintAttributes( 0 )
+    {
+    }
+
+    QImage image;
+
+    QwtScaleMap xMap;
+    QwtScaleMap yMap;
+    QRectF canvasRect;
+
+    int from;
+    int to;
+
+    QPainter::RenderHints renderHints;
+    int paintAttributes;
+};
+
 class QwtPlotCurve::PrivateData
 {
 public:
@@ -86,7 +223,11 @@ public:
         attributes( 0 ),
         paintAttributes( 
             QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints ),
-        legendAttributes( 0 )
+        legendAttributes( 0 ),
+        spatialIndex( NULL ),
+        streamData( NULL ),
+        isAppending( false ),
+        appendedFrom( -1 )
     {
         curveFitter = new QwtSplineCurveFitter;
     }
@@ -95,6 +236,7 @@ public:
     {
         delete symbol;
         delete curveFitter;
+        delete spatialIndex;
     }
 
     QwtPlotCurve::CurveStyle style;
@@ -110,6 +252,21 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    QwtSpatialIndex *spatialIndex;
+
+    // the data object, when it has been created by appendSamples()
+    QwtPointStreamData *streamData;
+
+    // the rendered curve, when CacheCurve is enabled
+    QwtCurveCache cache;
+
+    // samples are appended without modifying the previous ones
+    bool isAppending;
+
+    // index of the first sample, that has been appended by 
+    // appendSamples() after rendering the cache, or -1
+    int appendedFrom;
 };
 
 /*!
@@ -169,6 +326,9 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( !( d_data->paintAttributes & CacheCurve ) )
+        invalidateCache();
 }
 
 /*!
@@ -373,19 +533,54 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
     if ( to < 0 )
         to = numSamples - 1;
 
-    if ( qwtVerifyRange( numSamples, from, to ) > 0 )
-    {
-        painter->save();
-        painter->setPen( d_data->pen );
+    if ( qwtVerifyRange( numSamples, from, to ) <= 0 )
+        return;
 
+    if ( d_data->paintAttributes & SortedSamples )
+    {
         /*
-          Qt 4.0.0 is slow when drawing lines, but it's even
-          slower when the painter has a brush. So we don't
-          set the brush before we really need it.
+          Finding the range of visible samples by a binary search.
+          The interval is extended by the extent of the pen and 
+          the symbol, so that all samples affecting the canvas are included.
          */
 
-        drawCurve( painter, d_data->style, xMap, yMap, canvasRect, from, to );
-        painter->restore();
+        double margin = qMax( qreal( 1.0 ), d_data->pen.widthF() );
+        if ( d_data->symbol &&
+            ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
+        {
+            const QRect symbolRect = d_data->symbol->boundingRect();
+            margin += qMax( symbolRect.width(), symbolRect.height() );
+        }
+
+        double x1 = xMap.invTransform( canvasRect.left() - margin );
+        double x2 = xMap.invTransform( canvasRect.right() + margin );
+        if ( x1 > x2 )
+            qSwap( x1, x2 );
+
+        qwtVisibleRange( *data(), x1, x2, from, to );
+    }
+
+    if ( from <= to )
+    {
+        if ( ( d_data->paintAttributes & CacheCurve ) 
+            && ( d_data->style != NoCurve ) && qwtCanCache( painter ) )
+        {
+            drawCachedCurve( painter, xMap, yMap, canvasRect, from, to );
+        }
+        else
+        {
+            painter->save();
+            painter->setPen( d_data->pen );
+
+            /*
+              Qt 4.0.0 is slow when drawing lines, but it's even
+              slower when the painter has a brush. So we don't
+              set the brush before we really need it.
+             */
+
+            drawCurve( painter, d_data->style, xMap, yMap, canvasRect, from, to );
+            painter->restore();
+        }
 
         if ( d_data->symbol &&
             ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
@@ -398,6 +593,146 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
     }
 }
 
+/*!
+  \brief Draw the line part of a curve interval from the cache
+
+  The curve is rendered into an image, when the cache is invalid or 
+  doesn't match the scale maps, the canvas rectangle, the range of samples 
+  or the render hints of the painter. Otherwise the cached image is painted.
+
+  \param painter Painter
+  \param xMap x map
+  \param yMap y map
+  \param canvasRect Contents rectangle of the canvas
+  \param from index of the first point to be painted
+  \param to index of the last point to be painted
+
+  \sa CacheCurve, invalidateCache(), drawCurve()
+*/
+void QwtPlotCurve::drawCachedCurve( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const QRect rect = canvasRect.toAlignedRect();
+    if ( rect.isEmpty() )
+        return;
+
+#if QT_VERSION >= 0x050000 
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    const QSize scaledSize = rect.size() * pixelRatio;
+#else
+    const QSize scaledSize = rect.size();
+#endif
+
+    const QPainter::RenderHints renderHints = painter->renderHints();
+
+    PrivateData *d = d_data;
+
+    bool isValid = !( d->cache.image.isNull() || d->cache.image.size() != scaledSize
+        || d->cache.canvasRect != canvasRect || d->cache.from != from
+        || d->cache.renderHints != renderHints
+        || d->cache.paintAttributes != int( d->paintAttributes )
+        || d->cache.xMap != xMap || d->cache.yMap != yMap );
+
+    if ( isValid && to != d->cache.to )
+    {
+        /*
+          When the samples following the cached ones have been
+          appended by appendSamples() we can paint them on top
+          of the cached image - as long as the previous samples
+          don't depend on them. For any other reason of a
+          different range the curve has to be rendered again.
+         */
+
+        const bool doFill = ( d->brush.style() != Qt::NoBrush )
+            && ( d->brush.color().alpha() > 0 );
+
+        isValid = ( d->appendedFrom >= 0 ) 
+            && ( d->appendedFrom == d->cache.to + 1 )
+            && ( to > d->cache.to ) && !doFill 
+            && !( d->style == Lines && ( d->attributes & Fitted ) );
+    }
+
+    if ( isValid )
+    {
+        if ( to > d->cache.to )
+        {
+            // for lines and steps we need the connection 
+            // to the last sample, that has been painted
+
+            int first = d->cache.to;
+            if ( d->style != Lines && d->style != Steps )
+                first++;
+
+            QPainter imagePainter( &d->cache.image );
+            imagePainter.setRenderHints( renderHints );
+            imagePainter.translate( -rect.left(), -rect.top() );
+            imagePainter.setPen( d->pen );
+
+            drawCurve( &imagePainter, d->style, xMap, yMap, canvasRect, first, to );
+
+            d->cache.to = to;
+        }
+    }
+    else
+    {
+        d->cache.image = QImage( scaledSize, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000 
+        d->cache.image.setDevicePixelRatio( pixelRatio );
+#endif
+        d->cache.image.fill( Qt::transparent );
+
+        QPainter imagePainter( &d->cache.image );
+        imagePainter.setRenderHints( renderHints );
+        imagePainter.translate( -rect.left(), -rect.top() );
+        imagePainter.setPen( d->pen );
+
+        drawCurve( &imagePainter, d->style, xMap, yMap, canvasRect, from, to );
+
+        d->cache.xMap = xMap;
+        d->cache.yMap = yMap;
+        d->cache.canvasRect = canvasRect;
+        d->cache.from = from;
+        d->cache.to = to;
+        d->cache.renderHints = renderHints;
+        d->cache.paintAttributes = int( d->paintAttributes );
+    }
+
+    d->appendedFrom = -1;
+
+    painter->drawImage( rect.topLeft(), d->cache.image );
+}
+
+/*!
+  \brief Invalidate the cached image of the curve
+
+  The cache is invalidated automatically, whenever an attribute of the
+  curve has changed ( itemChanged() ) - beside appending samples 
+  ( appendSamples() ), what only renders the new samples into the cache.
+  But when modifying the samples without calling dataChanged() 
+  - f.e. those of a QwtCPointerData object - the cache has to be 
+  invalidated manually.
+
+  \sa CacheCurve, itemChanged()
+*/
+void QwtPlotCurve::invalidateCache()
+{
+    d_data->cache.image = QImage();
+    d_data->appendedFrom = -1;
+}
+
+/*!
+  \brief Invalidate the cache and update the plot
+  \sa invalidateCache(), QwtPlotItem::itemChanged()
+*/
+void QwtPlotCurve::itemChanged()
+{
+    if ( !d_data->isAppending )
+        invalidateCache();
+
+    QwtPlotSeriesItem::itemChanged();
+}
+
 /*!
   \brief Draw the line part (without symbols) of a curve interval.
   \param painter Painter
@@ -510,23 +845,69 @@ void QwtPlotCurve::drawLines( QPainter *painter,
         testPaintAttribute( FilterPointsAggressive ) );
 
     mapper.setBoundingRect( canvasRect );
+    mapper.setRenderThreadCount( renderThreadCount() );
+
+    if ( ( d_data->paintAttributes & ClipPolygons ) && !doFill )
+    {
+        // clipping the lines while mapping the points
+        mapper.setClipRect( clipRect );
+    }
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    /*
+      Series with a level of detail, like QwtPointPyramidData, can reduce
+      the samples to the ones, that make a difference for the pixel
+      columns. As this is only true for a polyline with rounded
+      coordinates we don't try it otherwise.
+     */
+
+    QVector<int> lodIndices;
+    if ( doAlign )
+        series->levelOfDetail( xMap, from, to, lodIndices );
+
+    const QwtIndexedPointData lodSeries( series, lodIndices );
+    if ( !lodIndices.isEmpty() )
+    {
+        series = &lodSeries;
+
+        from = 0;
+        to = lodIndices.size() - 1;
+    }
 
     if ( doIntegers )
     {
         QPolygon polyline = mapper.toPolygon( 
-            xMap, yMap, data(), from, to );
+            xMap, yMap, series, from, to );
 
         if ( testPaintAttribute( ClipPolygons ) )
         {
-            polyline = QwtClipper::clipPolygon( 
-                clipRect.toAlignedRect(), polyline, false );
+            // drawing the parts inside of the clip rectangle only
+
+            const QVector<QPolygon> polylines = QwtClipper::clipPolyline( 
+                clipRect.toAlignedRect(), polyline );
+
+            for ( int i = 0; i < polylines.size(); i++ )
+                QwtPainter::drawPolyline( painter, polylines[i] );
+        }
+        else
+        {
+            QwtPainter::drawPolyline( painter, polyline );
         }
+    }
+    else if ( mapper.clipRect().isValid() && !doFit )
+    {
+        // drawing the parts inside of the clip rectangle only
+
+        const QVector<QPolygonF> polylines = 
+            mapper.toPolylinesF( xMap, yMap, series, from, to );
 
-        QwtPainter::drawPolyline( painter, polyline );
+        for ( int i = 0; i < polylines.size(); i++ )
+            QwtPainter::drawPolyline( painter, polylines[i] );
     }
     else
     {
-        QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+        QPolygonF polyline = mapper.toPolygonF( xMap, yMap, series, from, to );
 
         if ( doFill )
         {
@@ -560,12 +941,6 @@ void QwtPlotCurve::drawLines( QPainter *painter,
         }
         else
         {
-            if ( testPaintAttribute( ClipPolygons ) )
-            {
-                polyline = QwtClipper::clipPolygonF( 
-                    clipRect, polyline, false );
-            }
-
             if ( doFit )
             {
                 if ( d_data->curveFitter->mode() == QwtCurveFitter::Path )
@@ -620,23 +995,55 @@ void QwtPlotCurve::drawSticks( QPainter *painter,
 
     const Qt::Orientation o = orientation();
 
-    const QwtSeriesData<QPointF> *series = data();
-
-    for ( int i = from; i <= to; i++ )
+    if ( d_data->paintAttributes & MinimizeMemory )
     {
-        const QPointF sample = series->sample( i );
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
+        QwtSeriesReader<QPointF> reader( *data(), from, to );
+        while ( reader.hasNext() )
         {
-            xi = qRound( xi );
-            yi = qRound( yi );
+            const QPointF &sample = reader.next();
+            double xi = xMap.transform( sample.x() );
+            double yi = yMap.transform( sample.y() );
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
+
+            if ( o == Qt::Horizontal )
+                QwtPainter::drawLine( painter, x0, yi, xi, yi );
+            else
+                QwtPainter::drawLine( painter, xi, y0, xi, yi );
         }
+    }
+    else
+    {
+        /*
+          When aligning, the sticks in the same pixel column 
+          are reduced to the shortest and the longest one. As 
+          the sticks are painted one by one, this is not possible
+          for translucent pens, where overlapping sticks blend.
+         */
 
-        if ( o == Qt::Horizontal )
-            QwtPainter::drawLine( painter, x0, yi, xi, yi );
-        else
-            QwtPainter::drawLine( painter, xi, y0, xi, yi );
+        const bool weedOut = ( painter->pen().color().alpha() == 255 ) 
+            && ( testPaintAttribute( FilterPoints ) || 
+                testPaintAttribute( FilterPointsAggressive ) );
+
+        QwtPointMapper mapper;
+        mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+        mapper.setFlag( QwtPointMapper::WeedOutPoints, weedOut );
+
+        const QPolygonF points = mapper.toSticks( 
+            xMap, yMap, data(), from, to, o );
+
+        for ( int i = 0; i < points.size(); i++ )
+        {
+            const QPointF &p = points[i];
+
+            if ( o == Qt::Horizontal )
+                QwtPainter::drawLine( painter, x0, p.y(), p.x(), p.y() );
+            else
+                QwtPainter::drawLine( painter, p.x(), y0, p.x(), p.y() );
+        }
     }
 
     painter->restore();
@@ -672,6 +1079,7 @@ void QwtPlotCurve::drawDots( QPainter *painter,
     QwtPointMapper mapper;
     mapper.setBoundingRect( canvasRect );
     mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+    mapper.setRenderThreadCount( renderThreadCount() );
 
     if ( d_data->paintAttributes & FilterPoints )
     {
@@ -703,11 +1111,10 @@ void QwtPlotCurve::drawDots( QPainter *painter,
     }
     else if ( d_data->paintAttributes & MinimizeMemory )
     {
-        const QwtSeriesData<QPointF> *series = data();
-
-        for ( int i = from; i <= to; i++ )
+        QwtSeriesReader<QPointF> reader( *data(), from, to );
+        while ( reader.hasNext() )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF &sample = reader.next();
 
             double xi = xMap.transform( sample.x() );
             double yi = yMap.transform( sample.y() );
@@ -761,47 +1168,31 @@ void QwtPlotCurve::drawSteps( QPainter *painter,
 {
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    QPolygonF polygon( 2 * ( to - from ) + 1 );
-    QPointF *points = polygon.data();
-
     bool inverted = orientation() == Qt::Vertical;
     if ( d_data->attributes & Inverted )
         inverted = !inverted;
 
-    const QwtSeriesData<QPointF> *series = data();
+    /*
+      When aligning, the corners in the same pixel column or row
+      are reduced to the first, last, minimum and maximum one.
+      Like for Dots this is done for opaque pens without 
+      antialiasing only, where the result is identical.
+     */
 
-    int i, ip;
-    for ( i = from, ip = 0; i <= to; i++, ip += 2 )
+    bool weedOut = false;
+    if ( testPaintAttribute( FilterPoints ) || 
+        testPaintAttribute( FilterPointsAggressive ) )
     {
-        const QPointF sample = series->sample( i );
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
-        {
-            xi = qRound( xi );
-            yi = qRound( yi );
-        }
-
-        if ( ip > 0 )
-        {
-            const QPointF &p0 = points[ip - 2];
-            QPointF &p = points[ip - 1];
+        weedOut = ( painter->pen().color().alpha() == 255 )
+            && !( painter->renderHints() & QPainter::Antialiasing );
+    }
 
-            if ( inverted )
-            {
-                p.rx() = p0.x();
-                p.ry() = yi;
-            }
-            else
-            {
-                p.rx() = xi;
-                p.ry() = p0.y();
-            }
-        }
+    QwtPointMapper mapper;
+    mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+    mapper.setFlag( QwtPointMapper::WeedOutPoints, weedOut );
 
-        points[ip].rx() = xi;
-        points[ip].ry() = yi;
-    }
+    QPolygonF polygon = mapper.toSteps( 
+        xMap, yMap, data(), from, to, inverted );
 
     if ( d_data->paintAttributes & ClipPolygons )
     {
@@ -1006,7 +1397,11 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
     const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
     mapper.setBoundingRect( clipRect );
 
-    const int chunkSize = 500;
+    // QwtSymbol composes symbols into images in parallel,
+    // what needs larger chunks to be effective
+
+    const int chunkSize = testPaintAttribute( QwtPlotCurve::MinimizeMemory )
+        ? 500 : 100000;
 
     for ( int i = from; i <= to; i += chunkSize )
     {
@@ -1016,7 +1411,10 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
             data(), i, i + n - 1 );
 
         if ( points.size() > 0 )
-            symbol.drawSymbols( painter, points );
+        {
+            symbol.drawSymbols( painter, points.constData(), 
+                points.size(), renderThreadCount() );
+        }
     }
 }
 
@@ -1054,6 +1452,162 @@ double QwtPlotCurve::baseline() const
     return d_data->baseline;
 }
 
+/*!
+  \brief Bounding rectangle of the samples inside of an x interval
+
+  When the SortedSamples paint attribute is set, the range of samples is
+  found by a binary search. Like in drawSeries() it includes one sample
+  of padding on each side, so that the lines leaving the interval are
+  inside the rectangle too. Its bounds are calculated by qwtBoundingRect(), 
+  what is O(log(n)) for a QwtArraySeriesData with an enabled range index.
+
+  Otherwise all samples have to be checked.
+
+  \param xInterval Interval of x values
+  \return Bounding rectangle
+
+  \sa QwtPlot::setAxisAutoScaleToVisibleRange(),
+      QwtArraySeriesData::setRangeIndexEnabled()
+*/
+QRectF QwtPlotCurve::boundingRectInXRange( const QwtInterval &xInterval ) const
+{
+    QRectF rect( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    const size_t numSamples = dataSize();
+    if ( numSamples <= 0 || !xInterval.isValid() )
+        return rect;
+
+    const double x1 = xInterval.minValue();
+    const double x2 = xInterval.maxValue();
+
+    if ( d_data->paintAttributes & SortedSamples )
+    {
+        int from = 0;
+        int to = static_cast<int>( numSamples ) - 1;
+
+        qwtVisibleRange( *data(), x1, x2, from, to );
+
+        if ( from <= to )
+            rect = qwtBoundingRect( *data(), from, to );
+
+        return rect;
+    }
+
+    double minX = 0.0;
+    double maxX = 0.0;
+    double minY = 0.0;
+    double maxY = 0.0;
+    bool isValid = false;
+
+    QwtSeriesReader<QPointF> reader( *data(), 0, numSamples - 1 );
+    while ( reader.hasNext() )
+    {
+        const QPointF &sample = reader.next();
+
+        if ( sample.x() < x1 || sample.x() > x2 )
+            continue;
+
+        if ( isValid )
+        {
+            minX = qMin( minX, sample.x() );
+            maxX = qMax( maxX, sample.x() );
+            minY = qMin( minY, sample.y() );
+            maxY = qMax( maxY, sample.y() );
+        }
+        else
+        {
+            minX = maxX = sample.x();
+            minY = maxY = sample.y();
+            isValid = true;
+        }
+    }
+
+    if ( isValid )
+        rect.setCoords( minX, minY, maxX, maxY );
+
+    return rect;
+}
+
+/*!
+  \brief En/Disable a spatial index for the samples
+
+  When enabled, closestPoint() and samplesInRect() use a QwtSpatialIndex,
+  that answers the queries without iterating over all samples.
+  The index is built on the first query after the samples have
+  been changed, what costs O(n * log(n)) operations. 
+
+  The index is worth the memory for curves with many samples, when 
+  queries are frequent - f.e. when tracking the closest point
+  while moving the mouse.
+
+  \param on On/Off
+  \note When modifying the samples without calling dataChanged(),
+        the index gets out of sync, unless the number of samples changes.
+
+  \sa isSpatialIndexEnabled(), dataChanged()
+*/
+void QwtPlotCurve::setSpatialIndexEnabled( bool on )
+{
+    if ( on == isSpatialIndexEnabled() )
+        return;
+
+    if ( on )
+    {
+        d_data->spatialIndex = new QwtSpatialIndex();
+    }
+    else
+    {
+        delete d_data->spatialIndex;
+        d_data->spatialIndex = NULL;
+    }
+}
+
+/*!
+  \return True, when a spatial index is used for queries
+  \sa setSpatialIndexEnabled()
+*/
+bool QwtPlotCurve::isSpatialIndexEnabled() const
+{
+    return d_data->spatialIndex != NULL;
+}
+
+/*!
+  \brief Invalidate the spatial index and the cache and update the plot
+
+  dataChanged() is called by setData(). When the samples of the 
+  current data object are modified in place - f.e. those of 
+  a QwtItemModelPointData - it has to be called manually.
+
+  \sa setSpatialIndexEnabled(), invalidateCache(), 
+      QwtPlotSeriesItem::dataChanged()
+*/
+void QwtPlotCurve::dataChanged()
+{
+    if ( data() != d_data->streamData )
+        d_data->streamData = NULL;
+
+    if ( d_data->spatialIndex )
+        d_data->spatialIndex->reset();
+
+    QwtPlotSeriesItem::dataChanged();
+}
+
+/*!
+  \return Spatial index, that is built, when it doesn't match the samples,
+          or NULL, when the index is disabled
+
+  \sa setSpatialIndexEnabled()
+*/
+const QwtSpatialIndex *QwtPlotCurve::spatialIndex() const
+{
+    QwtSpatialIndex *index = d_data->spatialIndex;
+
+    if ( index && index->size() != dataSize() )
+        index->build( *data() );
+
+    return index;
+}
+
 /*!
   Find the closest curve point for a specific position
 
@@ -1062,8 +1616,10 @@ double QwtPlotCurve::baseline() const
               the position and the closest curve point
   \return Index of the closest curve point, or -1 if none can be found
           ( f.e when the curve has no points )
-  \note closestPoint() implements a dumb algorithm, that iterates
-        over all points
+  \note Without a spatial index closestPoint() implements a dumb algorithm,
+        that iterates over all points
+
+  \sa setSpatialIndexEnabled()
 */
 int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
 {
@@ -1072,17 +1628,20 @@ int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
     if ( plot() == NULL || numSamples <= 0 )
         return -1;
 
-    const QwtSeriesData<QPointF> *series = data();
-
     const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
     const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
 
-    int index = -1;
+    const QwtSpatialIndex *index = spatialIndex();
+    if ( index )
+        return index->closestSample( *data(), xMap, yMap, pos, dist );
+
+    int idx = -1;
     double dmin = 1.0e10;
 
+    QwtSeriesReader<QPointF> reader( *data(), 0, numSamples - 1 );
     for ( uint i = 0; i < numSamples; i++ )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF &sample = reader.next();
 
         const double cx = xMap.transform( sample.x() ) - pos.x();
         const double cy = yMap.transform( sample.y() ) - pos.y();
@@ -1090,14 +1649,55 @@ int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
         const double f = qwtSqr( cx ) + qwtSqr( cy );
         if ( f < dmin )
         {
-            index = i;
+            idx = i;
             dmin = f;
         }
     }
     if ( dist )
         *dist = qSqrt( dmin );
 
-    return index;
+    return idx;
+}
+
+/*!
+  \brief Find the samples inside of a rectangle
+
+  samplesInRect() can be used to implement selections, f.e. from 
+  the rectangle of a QwtPlotPicker::selected() signal.
+
+  \param rect Rectangle in plot coordinates. Samples on the border
+              are included.
+  \return Indices of the samples inside of the rectangle in increasing order
+
+  \sa setSpatialIndexEnabled()
+*/
+QVector<int> QwtPlotCurve::samplesInRect( const QRectF &rect ) const
+{
+    const size_t numSamples = dataSize();
+    if ( numSamples <= 0 )
+        return QVector<int>();
+
+    const QwtSpatialIndex *index = spatialIndex();
+    if ( index )
+        return index->samplesInRect( *data(), rect );
+
+    const QRectF r = rect.normalized();
+
+    QVector<int> indices;
+
+    QwtSeriesReader<QPointF> reader( *data(), 0, numSamples - 1 );
+    for ( int i = 0; reader.hasNext(); i++ )
+    {
+        const QPointF &sample = reader.next();
+
+        if ( sample.x() >= r.left() && sample.x() <= r.right()
+            && sample.y() >= r.top() && sample.y() <= r.bottom() )
+        {
+            indices += i;
+        }
+    }
+
+    return indices;
 }
 
 /*!
@@ -1186,7 +1786,26 @@ QwtGraphic QwtPlotCurve::legendIcon( int index,
 */
 void QwtPlotCurve::setSamples( const QVector<QPointF> &samples )
 {
-    setData( new QwtPointSeriesData( samples ) );
+    QwtPointSeriesData *data = new QwtPointSeriesData( samples );
+    data->setBlockCopyEnabled( true );
+
+    setData( data );
+}
+
+/*!
+  \brief Initialize data with a shared column of x values
+         and an array of y values
+
+  \param xColumn x values, that might be shared with other curves
+  \param yData y values
+  \note QVector is implicitly shared
+
+  \sa QwtSharedXColumnData
+*/
+void QwtPlotCurve::setSamples( const QwtSharedXColumn &xColumn,
+    const QVector<double> &yData )
+{
+    setData( new QwtSharedXColumnData( xColumn, yData ) );
 }
 
 /*!
@@ -1204,6 +1823,127 @@ void QwtPlotCurve::setSamples( QwtSeriesData<QPointF> *data )
     setData( data );
 }
 
+/*!
+  \brief Append a sample
+
+  \param sample New sample
+  \sa appendSamples()
+*/
+void QwtPlotCurve::appendSample( const QPointF &sample )
+{
+    appendSamples( &sample, 1 );
+}
+
+/*!
+  \brief Append samples
+
+  \param samples Vector of points
+  \sa appendSamples()
+*/
+void QwtPlotCurve::appendSamples( const QVector<QPointF> &samples )
+{
+    appendSamples( samples.constData(), samples.size() );
+}
+
+/*!
+  \brief Append samples
+
+  On the first call the samples of the curve are copied into a 
+  QwtPointStreamData object, that replaces the data object of the curve.
+  The bounding rectangle of a QwtPointStreamData is updated
+  for each appended sample, so that autoscaling doesn't need to
+  iterate over all samples.
+
+  When CacheCurve is enabled and the scale maps don't change,
+  the next replot renders the appended samples only into the cached
+  image of the curve. So the costs for updating the curve depend on the
+  number of new samples, but not on the size of the series.
+
+  \param samples Array of points
+  \param count Number of points
+
+  \sa removeFirstSamples(), setMaxSamples(), QwtPointStreamData
+*/
+void QwtPlotCurve::appendSamples( const QPointF *samples, int count )
+{
+    if ( count <= 0 )
+        return;
+
+    QwtPointStreamData *series = streamData();
+
+    const size_t numSamples = series->size();
+    series->append( samples, count );
+
+    // when samples have been removed from the beginning 
+    // ( setMaxSamples() ) the cache has to be rebuilt
+
+    d_data->isAppending = ( series->size() == numSamples + count );
+    if ( d_data->isAppending && d_data->appendedFrom < 0 )
+        d_data->appendedFrom = static_cast<int>( numSamples );
+
+    dataChanged();
+    d_data->isAppending = false;
+}
+
+/*!
+  \brief Remove the oldest samples
+
+  \param count Number of samples to be removed
+  \sa appendSamples(), setMaxSamples()
+*/
+void QwtPlotCurve::removeFirstSamples( int count )
+{
+    if ( count <= 0 || dataSize() == 0 )
+        return;
+
+    streamData()->removeFirst( count );
+    dataChanged();
+}
+
+/*!
+  \brief Limit the number of samples to a sliding window
+
+  When appending samples the oldest samples are removed, so that
+  the curve doesn't have more than maxSamples.
+
+  \param maxSamples Maximum number of samples, 0 means unlimited
+  \sa appendSamples(), QwtPointStreamData::setMaxSize()
+*/
+void QwtPlotCurve::setMaxSamples( int maxSamples )
+{
+    const size_t numSamples = dataSize();
+
+    streamData()->setMaxSize( qMax( maxSamples, 0 ) );
+
+    if ( dataSize() != numSamples )
+        dataChanged();
+}
+
+/*!
+  \return Data object for appending samples
+
+  When the curve has not been populated by appendSamples() before,
+  its samples are copied into a new QwtPointStreamData object.
+*/
+QwtPointStreamData *QwtPlotCurve::streamData()
+{
+    if ( d_data->streamData == NULL || data() != d_data->streamData )
+    {
+        const size_t numSamples = dataSize();
+
+        QVector<QPointF> samples( static_cast<int>( numSamples ) );
+        if ( numSamples > 0 )
+            data()->copySamples( 0, numSamples, samples.data() );
+
+        QwtPointStreamData *streamData = new QwtPointStreamData( samples );
+
+        setData( streamData );
+        d_data->streamData = streamData;
+    }
+
+    return d_data->streamData;
+}
+
 #ifndef QWT_NO_COMPAT
 
 /*!
@@ -1214,16 +1954,22 @@ void QwtPlotCurve::setSamples( QwtSeriesData<QPointF> *data )
   It is important to keep the pointers
   during the lifetime of the underlying QwtCPointerData class.
 
+  For arrays of other types than double - f.e. float - use
+  setData( new QwtTypedCPointerData<float>( xData, yData, size ) ).
+
   \param xData pointer to x data
   \param yData pointer to y data
   \param size size of x and y
 
-  \sa QwtCPointerData
+  \sa QwtCPointerData, QwtTypedCPointerData
 */
 void QwtPlotCurve::setRawSamples( 
     const double *xData, const double *yData, int size )
 {
-    setData( new QwtCPointerData( xData, yData, size ) );
+    QwtCPointerData *data = new QwtCPointerData( xData, yData, size );
+    data->setBlockCopyEnabled( true );
+
+    setData( data );
 }
 
 /*!
@@ -1240,7 +1986,10 @@ void QwtPlotCurve::setRawSamples(
 void QwtPlotCurve::setSamples( 
     const double *xData, const double *yData, int size )
 {
-    setData( new QwtPointArrayData( xData, yData, size ) );
+    QwtPointArrayData *data = new QwtPointArrayData( xData, yData, size );
+    data->setBlockCopyEnabled( true );
+
+    setData( data );
 }
 
 /*!
@@ -1254,7 +2003,10 @@ void QwtPlotCurve::setSamples(
 void QwtPlotCurve::setSamples( const QVector<double> &xData,
     const QVector<double> &yData )
 {
-    setData( new QwtPointArrayData( xData, yData ) );
+    QwtPointArrayData *data = new QwtPointArrayData( xData, yData );
+    data->setBlockCopyEnabled( true );
+
+    setData( data );
 }
 
 #endif // !QWT_NO_COMPAT
@@ -22,6 +22,9 @@ class QPolygonF;
 class QwtScaleMap;
 class QwtSymbol;
 class QwtCurveFitter;
+class QwtSpatialIndex;
+class QwtPointStreamData;
+class QwtSharedXColumn;
 
 /*!
   \brief A plot item, that represents a series of points
@@ -187,6 +190,13 @@ public:
           duplicates, or paintings outside the visible area. Might have a
           notable impact on curves with many close points.
           Only a couple of very basic filtering algorithms are implemented.
+
+          For the Steps and Sticks styles, when drawing to a paint device
+          in integer coordinates with an opaque pen, the chunks of
+          points mapped to the same pixel column ( or row ) are reduced
+          to the points, that make a visible difference ( see 
+          QwtPointMapper::toSteps(), QwtPointMapper::toSticks() ). 
+          For Steps this is also not done, when antialiasing is enabled.
          */
         FilterPoints = 0x02,
 
@@ -222,13 +232,50 @@ public:
           The algorithm is very fast and effective for huge datasets, and can be used
           inside a replot cycle.
 
-          \note Implemented for QwtPlotCurve::Lines only
+          \note For QwtPlotCurve::Lines only. For the Steps and Sticks 
+                styles it has the same effect as FilterPoints.
           \note As this algo replaces many small lines by a long one
                 a nasty bug of the raster paint engine ( Qt 4.8, Qt 5.1 - 5.3 )
                 becomes more dominant. For these versions the bug can be
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+          The x coordinates of the samples are sorted in increasing
+          or decreasing order.
+
+          The range of samples, that is visible on the canvas, can be
+          found by a binary search then. The samples outside - beside
+          one sample on each side for the lines entering the canvas -
+          are ignored, before they get translated. When zooming deep into
+          a huge series only a small fraction of the samples has to be
+          processed.
+
+          \note The result is undefined, when the samples are not sorted
+         */
+        SortedSamples = 0x20,
+
+        /*!
+          Render the line part of the curve ( all styles ) into an image,
+          that is cached until the curve changes ( itemChanged(), 
+          dataChanged() ) or it is painted with different scale maps.
+          Replotting the canvas for other reasons - f.e. because another 
+          curve has been updated - only needs to paint the image then.
+
+          Samples, that have been added by appendSamples(), are rendered
+          on top of the cached image, as long as the scale maps don't
+          change and the curve is not filled or fitted. This is an
+          alternative for QwtPlotDirectPainter, that survives
+          replots and resizing.
+
+          The cache is only used for paint devices with integer 
+          coordinates ( f.e. widgets on screen ).
+
+          \note The symbols are not cached
+          \sa invalidateCache()
+         */
+        CacheCurve = 0x40
     };
 
     //! Paint attributes
@@ -253,9 +300,20 @@ public:
     void setSamples( const QVector<double> &xData, const QVector<double> &yData );
 #endif
     void setSamples( const QVector<QPointF> & );
+    void setSamples( const QwtSharedXColumn &, const QVector<double> &yData );
     void setSamples( QwtSeriesData<QPointF> * );
 
+    void appendSample( const QPointF & );
+    void appendSamples( const QVector<QPointF> & );
+    void appendSamples( const QPointF *samples, int count );
+    void removeFirstSamples( int count );
+    void setMaxSamples( int maxSamples );
+
+    void setSpatialIndexEnabled( bool on );
+    bool isSpatialIndexEnabled() const;
+
     virtual int closestPoint( const QPoint &pos, double *dist = NULL ) const;
+    QVector<int> samplesInRect( const QRectF & ) const;
 
     double minXValue() const;
     double maxXValue() const;
@@ -290,8 +348,14 @@ public:
 
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const;
 
-protected:
+    virtual QRectF boundingRectInXRange( const QwtInterval & ) const;
+
+    virtual void itemChanged();
+    void invalidateCache();
 
+    virtual void dataChanged();
+
+protected:
     void init();
 
     virtual void drawCurve( QPainter *p, int style,
@@ -325,6 +389,13 @@ protected:
     void closePolyline( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &, QPolygonF & ) const;
 
+    void drawCachedCurve( QPainter *p,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const;
+
+    const QwtSpatialIndex *spatialIndex() const;
+    QwtPointStreamData *streamData();
+
 private:
     class PrivateData;
     PrivateData *d_data;
@@ -305,7 +305,7 @@ bool QwtPlotItem::testRenderHint( RenderHint hint ) const
 
 /*!
    On multi core systems rendering of certain plot item 
-   ( f.e QwtPlotRasterItem ) can be done in parallel in 
+   ( f.e QwtPlotRasterItem or QwtPlotCurve ) can be done in parallel in 
    several threads.
 
    The default setting is set to 1.
@@ -539,6 +539,23 @@ QRectF QwtPlotItem::boundingRect() const
     return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
 }
 
+/*!
+   \brief Bounding rectangle of the parts of the item inside of an x interval
+
+   Used by QwtPlot::updateAxes() for y axes, that are autoscaled 
+   to the visible range of the x axis.
+
+   \param xInterval Interval of x values
+   \return boundingRect()
+
+   \sa QwtPlot::setAxisAutoScaleToVisibleRange()
+*/
+QRectF QwtPlotItem::boundingRectInXRange( const QwtInterval &xInterval ) const
+{
+    Q_UNUSED( xInterval );
+    return boundingRect();
+}
+
 /*!
    \brief Calculate a hint for the canvas margin
 
@@ -21,6 +21,7 @@
 class QPainter;
 class QwtScaleMap;
 class QwtScaleDiv;
+class QwtInterval;
 class QwtPlot;
 
 /*!
@@ -267,6 +268,7 @@ public:
         const QRectF &canvasRect ) const = 0;
 
     virtual QRectF boundingRect() const;
+    virtual QRectF boundingRectInXRange( const QwtInterval &xInterval ) const;
 
     virtual void getCanvasMarginHint( 
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
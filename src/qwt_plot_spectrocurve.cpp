@@ -12,6 +12,297 @@
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
+#include <qimage.h>
+#include <qmath.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+class QwtColoredDot
+{
+public:
+    QPointF pos;
+    QRgb rgb;
+
+    // index of the color in the color table
+    uchar index;
+};
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtMapDotsCommand
+{
+public:
+    const QwtSeriesData<QwtPoint3D> *series;
+    int from;
+    int to;
+
+    const QwtColorMap *colorMap;
+    QwtInterval colorRange;
+
+    // 256 colors, or NULL for mapping each value with QwtColorMap::rgb()
+    const QRgb *colorTable;
+
+    bool doAlign;
+    bool doClip;
+    QRectF clipRect;
+};
+
+class QwtRenderDotsCommand
+{
+public:
+    const QVector< QVector<QwtColoredDot> > *chunks;
+    QPoint pos;
+    double radius;
+    bool antialiased;
+    QImage *image;
+};
+
+static uint qwtThreadCount( uint numThreads, int numPoints )
+{
+#if QWT_USE_THREADS
+    // below this number of points per thread the overhead
+    // for starting the threads is not worth it
+    const int minChunkSize = 10000;
+
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, uint( numPoints / minChunkSize ) );
+
+    return qMax( numThreads, 1u );
+#else
+    Q_UNUSED( numThreads )
+    Q_UNUSED( numPoints )
+
+    return 1;
+#endif
+}
+
+static void qwtMapDots( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtMapDotsCommand command, QVector<QwtColoredDot> *dots )
+{
+    dots->reserve( command.to - command.from + 1 );
+
+    QwtColoredDot dot;
+    dot.index = 0;
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtPoint3D sample = command.series->sample( i );
+
+        double xi = xMap.transform( sample.x() );
+        double yi = yMap.transform( sample.y() );
+        if ( command.doAlign )
+        {
+            xi = qRound( xi );
+            yi = qRound( yi );
+        }
+
+        if ( command.doClip && !command.clipRect.contains( xi, yi ) )
+            continue;
+
+        dot.pos = QPointF( xi, yi );
+
+        if ( command.colorTable )
+        {
+            dot.index = command.colorMap->colorIndex(
+                256, command.colorRange, sample.z() );
+
+            dot.rgb = command.colorTable[dot.index];
+        }
+        else
+        {
+            dot.rgb = command.colorMap->rgb( 
+                command.colorRange, sample.z() );
+        }
+
+        dots->append( dot );
+    }
+}
+
+/*
+  Map the samples to positions and colors, each thread
+  maps a chunk of the samples. The order of the samples is
+  the order of the chunks.
+ */
+static QVector< QVector<QwtColoredDot> > qwtMapDotsChunks( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    QwtMapDotsCommand command, uint numThreads )
+{
+    const int from = command.from;
+    const int to = command.to;
+
+    numThreads = qwtThreadCount( numThreads, to - from + 1 );
+
+    QVector< QVector<QwtColoredDot> > chunks( numThreads );
+
+#if QWT_USE_THREADS
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+    QList< QFuture<void> > futures;
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        command.from = from + i * numPoints;
+        command.to = ( i == numThreads - 1 ) 
+            ? to : command.from + numPoints - 1;
+
+        if ( i == numThreads - 1 )
+        {
+            qwtMapDots( xMap, yMap, command, &chunks[i] );
+        }
+        else
+        {
+            futures += QtConcurrent::run( &qwtMapDots, 
+                xMap, yMap, command, &chunks[i] );
+        }
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtMapDots( xMap, yMap, command, &chunks[0] );
+#endif
+
+    return chunks;
+}
+
+static inline QRgb qwtByteMul( QRgb rgb, uint a )
+{
+    uint rb = ( rgb & 0xff00ff ) * a;
+    rb = ( ( rb + ( ( rb >> 8 ) & 0xff00ff ) + 0x800080 ) >> 8 ) & 0xff00ff;
+
+    uint ag = ( ( rgb >> 8 ) & 0xff00ff ) * a;
+    ag = ( ag + ( ( ag >> 8 ) & 0xff00ff ) + 0x800080 ) & 0xff00ff00;
+
+    return rb | ag;
+}
+
+static inline void qwtBlendPixel( QRgb *pixel, QRgb rgb, double coverage )
+{
+    // rgb is premultiplied
+    if ( coverage < 1.0 )
+        rgb = qwtByteMul( rgb, qRound( coverage * 255 ) );
+
+    const uint alpha = qAlpha( rgb );
+    if ( alpha == 255 )
+        *pixel = rgb;
+    else if ( alpha > 0 )
+        *pixel = rgb + qwtByteMul( *pixel, 255 - alpha );
+}
+
+static inline double qwtOverlap( double a1, double a2, double b1, double b2 )
+{
+    return qMax( 0.0, qMin( a2, b2 ) - qMax( a1, b1 ) );
+}
+
+/*
+  Compose the dots into the rows [y1, y2] of the image. Like in 
+  QwtPointMapper::toImage() the center of pixel (i, j) is at (i, j).
+  Each thread works on a band of rows of its own, but iterates 
+  over all dots, so that overlapping dots are composed in the 
+  order of the samples.
+ */
+static void qwtRenderDots( const QwtRenderDotsCommand command, 
+    int y1, int y2 )
+{
+    QImage *image = command.image;
+
+    const int w = image->width();
+    const double r = command.radius;
+
+    uchar *bits = image->bits();
+    const int bytesPerLine = image->bytesPerLine();
+
+    const QVector< QVector<QwtColoredDot> > &chunks = *command.chunks;
+
+    QRgb rgb = 0;
+    QRgb premultipliedRgb = 0;
+
+    for ( int k = 0; k < chunks.size(); k++ )
+    {
+        const QwtColoredDot *dots = chunks[k].constData();
+        const int numDots = chunks[k].size();
+
+        for ( int n = 0; n < numDots; n++ )
+        {
+            const QwtColoredDot &dot = dots[n];
+
+            const double x = dot.pos.x() - command.pos.x();
+            const double y = dot.pos.y() - command.pos.y();
+
+            if ( x + r < -1.0 || x - r > w || y + r < y1 - 1 || y - r > y2 + 1 )
+                continue;
+
+            if ( dot.rgb != rgb )
+            {
+                rgb = dot.rgb;
+                premultipliedRgb = qPremultiply( rgb );
+            }
+
+            if ( r <= 0.5 )
+            {
+                const int i = qFloor( x + 0.5 );
+                const int j = qFloor( y + 0.5 );
+
+                if ( i >= 0 && i < w && j >= y1 && j <= y2 )
+                {
+                    QRgb *pixel = reinterpret_cast<QRgb *>( 
+                        bits + j * bytesPerLine ) + i;
+
+                    qwtBlendPixel( pixel, premultipliedRgb, 1.0 );
+                }
+
+                continue;
+            }
+
+            int i1, i2, j1, j2;
+            if ( command.antialiased )
+            {
+                i1 = qCeil( x - r - 0.5 );
+                i2 = qFloor( x + r + 0.5 );
+                j1 = qCeil( y - r - 0.5 );
+                j2 = qFloor( y + r + 0.5 );
+            }
+            else
+            {
+                i1 = qFloor( x - r ) + 1;
+                i2 = qFloor( x + r );
+                j1 = qFloor( y - r ) + 1;
+                j2 = qFloor( y + r );
+            }
+
+            i1 = qMax( i1, 0 );
+            i2 = qMin( i2, w - 1 );
+            j1 = qMax( j1, y1 );
+            j2 = qMin( j2, y2 );
+
+            for ( int j = j1; j <= j2; j++ )
+            {
+                double cy = 1.0;
+                if ( command.antialiased )
+                    cy = qwtOverlap( j - 0.5, j + 0.5, y - r, y + r );
+
+                QRgb *line = reinterpret_cast<QRgb *>( bits + j * bytesPerLine );
+
+                for ( int i = i1; i <= i2; i++ )
+                {
+                    double coverage = cy;
+                    if ( command.antialiased )
+                        coverage *= qwtOverlap( i - 0.5, i + 0.5, x - r, x + r );
+
+                    if ( coverage > 0.0 )
+                        qwtBlendPixel( line + i, premultipliedRgb, coverage );
+                }
+            }
+        }
+    }
+}
 
 class QwtPlotSpectroCurve::PrivateData
 {
@@ -31,7 +322,6 @@ public:
 
     QwtColorMap *colorMap;
     QwtInterval colorRange;
-    QVector<QRgb> colorTable;
     double penWidth;
     QwtPlotSpectroCurve::PaintAttributes paintAttributes;
 };
@@ -255,6 +545,17 @@ void QwtPlotSpectroCurve::drawSeries( QPainter *painter,
 /*!
   Draw a subset of the points
 
+  The samples are mapped to positions and colors first - in parallel, 
+  when QwtPlotItem::renderThreadCount() is not 1. Then the dots are 
+  grouped by the 256 colors of the color table, so that all dots of the 
+  same color are painted with one call of QPainter::drawPoints(). 
+  As a side effect overlapping dots of different colors are not painted 
+  in the order of the samples, and the colors of a QwtColorMap::RGB
+  color map are reduced to 256 colors.
+
+  When ImageBuffer is enabled the dots are composed into an image
+  in the order of the samples instead.
+
   \param painter Painter
   \param xMap Maps x-values into pixel coordinates.
   \param yMap Maps y-values into pixel coordinates.
@@ -263,7 +564,7 @@ void QwtPlotSpectroCurve::drawSeries( QPainter *painter,
   \param to Index of the last sample to be painted. If to < 0 the
          series will be painted to its last sample.
 
-  \sa drawSeries()
+  \sa drawSeries(), setPaintAttribute()
 */
 void QwtPlotSpectroCurve::drawDots( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -272,50 +573,113 @@ void QwtPlotSpectroCurve::drawDots( QPainter *painter,
     if ( !d_data->colorRange.isValid() )
         return;
 
-    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool doImage = 
+        d_data->paintAttributes & QwtPlotSpectroCurve::ImageBuffer;
 
-    const QwtColorMap::Format format = d_data->colorMap->format();
-    if ( format == QwtColorMap::Indexed )
-        d_data->colorTable = d_data->colorMap->colorTable256();
+    const QRect rect = canvasRect.toAlignedRect();
+    if ( doImage && rect.isEmpty() )
+        return;
 
-    const QwtSeriesData<QwtPoint3D> *series = data();
+    // grouping by color needs a color table, the image
+    // can be composed from the exact colors of a RGB color map
 
-    for ( int i = from; i <= to; i++ )
+    QVector<QRgb> colorTable;
+    if ( d_data->colorMap->format() == QwtColorMap::Indexed )
+        colorTable = d_data->colorMap->colorTable256();
+    else if ( !doImage )
+        colorTable = d_data->colorMap->colorTable( 256 );
+
+    QwtMapDotsCommand command;
+    command.series = data();
+    command.from = from;
+    command.to = to;
+    command.colorMap = d_data->colorMap;
+    command.colorRange = d_data->colorRange;
+    command.colorTable = colorTable.isEmpty() ? NULL : colorTable.constData();
+    command.doAlign = QwtPainter::roundingAlignment( painter );
+    command.doClip = 
+        d_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints;
+    command.clipRect = canvasRect;
+
+    if ( doImage )
     {
-        const QwtPoint3D sample = series->sample( i );
+        // the dots outside of the image are ignored anyway
+        command.doClip = false;
+    }
 
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
-        {
-            xi = qRound( xi );
-            yi = qRound( yi );
-        }
+    const QVector< QVector<QwtColoredDot> > chunks = 
+        qwtMapDotsChunks( xMap, yMap, command, renderThreadCount() );
 
-        if ( d_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints )
+    if ( doImage )
+    {
+        QImage image( rect.size(), QImage::Format_ARGB32_Premultiplied );
+        image.fill( 0 );
+
+        QwtRenderDotsCommand renderCommand;
+        renderCommand.chunks = &chunks;
+        renderCommand.pos = rect.topLeft();
+        renderCommand.radius = 0.5 * qMax( d_data->penWidth, 1.0 );
+        renderCommand.antialiased = 
+            painter->testRenderHint( QPainter::Antialiasing );
+        renderCommand.image = &image;
+
+#if QWT_USE_THREADS
+        int numDots = 0;
+        for ( int i = 0; i < chunks.size(); i++ )
+            numDots += chunks[i].size();
+
+        // each thread needs a band of at least a couple of rows
+        const uint numThreads = qMin( 
+            qwtThreadCount( renderThreadCount(), numDots ), 
+            uint( qMax( image.height() / 16, 1 ) ) );
+
+        const int numRows = image.height() / numThreads;
+
+        QList< QFuture<void> > futures;
+        for ( uint i = 0; i < numThreads; i++ )
         {
-            if ( !canvasRect.contains( xi, yi ) )
-                continue;
+            const int y1 = i * numRows;
+            if ( i == numThreads - 1 )
+            {
+                qwtRenderDots( renderCommand, y1, image.height() - 1 );
+            }
+            else
+            {
+                futures += QtConcurrent::run( &qwtRenderDots, 
+                    renderCommand, y1, y1 + numRows - 1 );
+            }
         }
 
-        if ( format == QwtColorMap::RGB )
-        {
-            const QRgb rgb = d_data->colorMap->rgb(
-                d_data->colorRange, sample.z() );
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#else
+        qwtRenderDots( renderCommand, 0, image.height() - 1 );
+#endif
 
-            painter->setPen( QPen( QColor::fromRgba( rgb ), d_data->penWidth ) );
-        }
-        else
-        {
-            const unsigned char index = d_data->colorMap->colorIndex(
-                256, d_data->colorRange, sample.z() );
+        painter->drawImage( rect, image );
+        return;
+    }
 
-            painter->setPen( QPen( QColor::fromRgba( d_data->colorTable[index] ), 
-                d_data->penWidth ) );
-        }
+    // grouping the dots by color
+
+    QVector<QPolygonF> buckets( colorTable.size() );
+
+    for ( int i = 0; i < chunks.size(); i++ )
+    {
+        const QwtColoredDot *dots = chunks[i].constData();
+        const int numDots = chunks[i].size();
 
-        QwtPainter::drawPoint( painter, QPointF( xi, yi ) );
+        for ( int j = 0; j < numDots; j++ )
+            buckets[ dots[j].index ] += dots[j].pos;
     }
 
-    d_data->colorTable.clear();
+    for ( int i = 0; i < buckets.size(); i++ )
+    {
+        if ( buckets[i].isEmpty() )
+            continue;
+
+        painter->setPen( QPen( QColor::fromRgba( colorTable[i] ), 
+            d_data->penWidth ) );
+        QwtPainter::drawPoints( painter, buckets[i] );
+    }
 }
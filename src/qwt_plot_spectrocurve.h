@@ -29,7 +29,19 @@ public:
     enum PaintAttribute
     {
         //! Clip points outside the canvas rectangle
-        ClipPoints = 1
+        ClipPoints = 1,
+
+        /*!
+          Render the points to a temporary image and paint the image.
+          The colored dots are composed without QPainter, what is
+          by magnitudes faster for a huge amount of points. 
+          The image is rendered in parallel, when 
+          QwtPlotItem::renderThreadCount() is not 1.
+
+          The dots are squares of the pen width, that are
+          antialiased, when the painter has QPainter::Antialiasing enabled.
+         */
+        ImageBuffer = 2
     };
 
     //! Paint attributes
@@ -547,6 +547,14 @@ void QwtPlotSpectrogram::renderTile(
 
     const bool hasGaps = !d_data->data->testAttribute( QwtRasterData::WithoutGaps );
 
+    // the x coordinates are the same for all lines of the tile
+
+    QVector<double> xValues( tile.width() );
+    for ( int i = 0; i < xValues.size(); i++ )
+        xValues[i] = tile.left() + i;
+
+    xMap.invTransform( xValues.constData(), xValues.data(), xValues.size() );
+
     if ( d_data->colorMap->format() == QwtColorMap::RGB )
     {
         const int numColors = d_data->colorTable.size();
@@ -560,9 +568,9 @@ void QwtPlotSpectrogram::renderTile(
             QRgb *line = reinterpret_cast<QRgb *>( image->scanLine( y ) );
             line += tile.left();
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
+            for ( int i = 0; i < xValues.size(); i++ )
             {
-                const double tx = xMap.invTransform( x );
+                const double tx = xValues[i];
 
                 const double value = d_data->data->value( tx, ty );
 
@@ -591,9 +599,9 @@ void QwtPlotSpectrogram::renderTile(
             unsigned char *line = image->scanLine( y );
             line += tile.left();
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
+            for ( int i = 0; i < xValues.size(); i++ )
             {
-                const double tx = xMap.invTransform( x );
+                const double tx = xValues[i];
 
                 const double value = d_data->data->value( tx, ty );
 
@@ -22,7 +22,8 @@
 QwtPointArrayData::QwtPointArrayData(
         const QVector<double> &x, const QVector<double> &y ):
     d_x( x ),
-    d_y( y )
+    d_y( y ),
+    d_blockCopyEnabled( false )
 {
 }
 
@@ -35,7 +36,8 @@ QwtPointArrayData::QwtPointArrayData(
   \sa QwtPlotCurve::setData(), QwtPlotCurve::setSamples()
 */
 QwtPointArrayData::QwtPointArrayData( const double *x,
-        const double *y, size_t size )
+        const double *y, size_t size ):
+    d_blockCopyEnabled( false )
 {
     d_x.resize( size );
     ::memcpy( d_x.data(), x, size * sizeof( double ) );
@@ -77,6 +79,32 @@ QPointF QwtPointArrayData::sample( size_t index ) const
     return QPointF( d_x[int( index )], d_y[int( index )] );
 }
 
+/*!
+  Copy a block of samples into a buffer
+
+  When isBlockCopyEnabled() the samples are copied from the arrays 
+  without calling sample().
+
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+*/
+void QwtPointArrayData::copySamples(
+    size_t from, size_t count, QPointF *samples ) const
+{
+    if ( !d_blockCopyEnabled )
+    {
+        QwtSeriesData<QPointF>::copySamples( from, count, samples );
+        return;
+    }
+
+    const double *x = d_x.constData() + from;
+    const double *y = d_y.constData() + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        samples[i] = QPointF( x[i], y[i] );
+}
+
 //! \return Array of the x-values
 const QVector<double> &QwtPointArrayData::xData() const
 {
@@ -89,6 +117,31 @@ const QVector<double> &QwtPointArrayData::yData() const
     return d_y;
 }
 
+/*!
+  \brief En/Disable reading the vectors directly in copySamples()
+
+  Copying the samples from the vectors is much faster than calling
+  the virtual sample() for each of them. But it is only correct
+  as long as sample() is not overloaded to modify the samples, what
+  is the reason why it is disabled by default.
+
+  \param on On/Off
+  \sa isBlockCopyEnabled(), copySamples(), QwtPlotCurve::setSamples()
+*/
+void QwtPointArrayData::setBlockCopyEnabled( bool on )
+{
+    d_blockCopyEnabled = on;
+}
+
+/*!
+  \return True, when copySamples() reads the vectors directly
+  \sa setBlockCopyEnabled()
+*/
+bool QwtPointArrayData::isBlockCopyEnabled() const
+{
+    return d_blockCopyEnabled;
+}
+
 /*!
   Constructor
 
@@ -106,7 +159,8 @@ QwtCPointerData::QwtCPointerData(
         const double *x, const double *y, size_t size ):
     d_x( x ),
     d_y( y ),
-    d_size( size )
+    d_size( size ),
+    d_blockCopyEnabled( false )
 {
 }
 
@@ -143,6 +197,32 @@ QPointF QwtCPointerData::sample( size_t index ) const
     return QPointF( d_x[int( index )], d_y[int( index )] );
 }
 
+/*!
+  Copy a block of samples into a buffer
+
+  When isBlockCopyEnabled() the samples are copied from the memory 
+  blocks without calling sample().
+
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+*/
+void QwtCPointerData::copySamples(
+    size_t from, size_t count, QPointF *samples ) const
+{
+    if ( !d_blockCopyEnabled )
+    {
+        QwtSeriesData<QPointF>::copySamples( from, count, samples );
+        return;
+    }
+
+    const double *x = d_x + from;
+    const double *y = d_y + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        samples[i] = QPointF( x[i], y[i] );
+}
+
 //! \return Array of the x-values
 const double *QwtCPointerData::xData() const
 {
@@ -155,6 +235,31 @@ const double *QwtCPointerData::yData() const
     return d_y;
 }
 
+/*!
+  \brief En/Disable reading the memory blocks directly in copySamples()
+
+  Copying the samples from the memory blocks is much faster than calling
+  the virtual sample() for each of them. But it is only correct
+  as long as sample() is not overloaded to modify the samples, what
+  is the reason why it is disabled by default.
+
+  \param on On/Off
+  \sa isBlockCopyEnabled(), copySamples(), QwtPlotCurve::setRawSamples()
+*/
+void QwtCPointerData::setBlockCopyEnabled( bool on )
+{
+    d_blockCopyEnabled = on;
+}
+
+/*!
+  \return True, when copySamples() reads the memory blocks directly
+  \sa setBlockCopyEnabled()
+*/
+bool QwtCPointerData::isBlockCopyEnabled() const
+{
+    return d_blockCopyEnabled;
+}
+
 /*!
    Constructor
 
@@ -166,7 +271,8 @@ const double *QwtCPointerData::yData() const
 QwtSyntheticPointData::QwtSyntheticPointData(
         size_t size, const QwtInterval &interval ):
     d_size( size ),
-    d_interval( interval )
+    d_interval( interval ),
+    d_isCacheEnabled( false )
 {
 }
 
@@ -179,6 +285,7 @@ QwtSyntheticPointData::QwtSyntheticPointData(
 void QwtSyntheticPointData::setSize( size_t size )
 {
     d_size = size;
+    updateCache( false );
 }
 
 /*!
@@ -199,6 +306,7 @@ size_t QwtSyntheticPointData::size() const
 void QwtSyntheticPointData::setInterval( const QwtInterval &interval )
 {
     d_interval = interval.normalized();
+    updateCache( false );
 }
 
 /*!
@@ -226,6 +334,8 @@ void QwtSyntheticPointData::setRectOfInterest( const QRectF &rect )
     d_rectOfInterest = rect;
     d_intervalOfInterest = QwtInterval(
         rect.left(), rect.right() ).normalized();
+
+    updateCache( false );
 }
 
 /*!
@@ -246,6 +356,9 @@ QRectF QwtSyntheticPointData::rectOfInterest() const
   reimplement this method using the characteristics of the series
   ( if possible ).
 
+  When caching is enabled the bounding rectangle is calculated
+  together with the points.
+
   \return Bounding rectangle
 */
 QRectF QwtSyntheticPointData::boundingRect() const
@@ -256,6 +369,9 @@ QRectF QwtSyntheticPointData::boundingRect() const
         return QRectF( 1.0, 1.0, -2.0, -2.0 ); // something invalid
     }
 
+    if ( d_isCacheEnabled )
+        return d_boundingRect;
+
     return qwtBoundingRect( *this );
 }
 
@@ -273,12 +389,170 @@ QPointF QwtSyntheticPointData::sample( size_t index ) const
     if ( index >= d_size )
         return QPointF( 0, 0 );
 
+    if ( d_isCacheEnabled )
+        return d_samples[ static_cast<int>( index ) ];
+
     const double xValue = x( index );
     const double yValue = y( xValue );
 
     return QPointF( xValue, yValue );
 }
 
+/*!
+  \brief Copy a block of samples into a buffer
+
+  The samples are copied from the cache - or calculated in blocks
+  by yValues(), when caching is disabled.
+
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+
+  \sa setCacheEnabled()
+*/
+void QwtSyntheticPointData::copySamples(
+    size_t from, size_t count, QPointF *samples ) const
+{
+    if ( d_isCacheEnabled )
+    {
+        ::memcpy( samples, d_samples.constData() + from,
+            count * sizeof( QPointF ) );
+
+        return;
+    }
+
+    const size_t blockSize = 256;
+
+    double xValues[ blockSize ];
+    double yValues[ blockSize ];
+
+    for ( size_t i = 0; i < count; i += blockSize )
+    {
+        const size_t n = qMin( blockSize, count - i );
+
+        for ( size_t j = 0; j < n; j++ )
+            xValues[j] = x( static_cast<uint>( from + i + j ) );
+
+        this->yValues( xValues, yValues, n );
+
+        for ( size_t j = 0; j < n; j++ )
+            samples[i + j] = QPointF( xValues[j], yValues[j] );
+    }
+}
+
+/*!
+   \brief Calculate y values for an array of x values
+
+   The default implementation calls y() for each value.
+
+   \param xValues Array of x values
+   \param yValues Array for the calculated y values
+   \param count Number of values
+
+   \sa y(), copySamples()
+*/
+void QwtSyntheticPointData::yValues( const double *xValues,
+    double *yValues, size_t count ) const
+{
+    for ( size_t i = 0; i < count; i++ )
+        yValues[i] = y( xValues[i] );
+}
+
+/*!
+   \brief En/Disable caching of the points
+
+   When caching is enabled, all points are calculated at once, 
+   whenever the number of points or the interval, they are 
+   calculated for, changes. sample() and copySamples() return the 
+   cached points then.
+
+   The points are calculated immediately, so that a derived class
+   enabling the cache in its constructor has to be ready for
+   calls of y() and yValues().
+
+   \param on On/Off
+   \sa isCacheEnabled(), invalidateCache()
+*/
+void QwtSyntheticPointData::setCacheEnabled( bool on )
+{
+    if ( on != d_isCacheEnabled )
+    {
+        d_isCacheEnabled = on;
+        updateCache( true );
+    }
+}
+
+/*!
+  \return True, when the points are cached
+  \sa setCacheEnabled()
+*/
+bool QwtSyntheticPointData::isCacheEnabled() const
+{
+    return d_isCacheEnabled;
+}
+
+/*!
+   \brief Recalculate the cached points
+
+   invalidateCache() has to be called, when the function
+   implemented by y() or yValues() changes and caching is enabled.
+
+   \sa setCacheEnabled()
+*/
+void QwtSyntheticPointData::invalidateCache()
+{
+    updateCache( true );
+}
+
+QwtInterval QwtSyntheticPointData::effectiveInterval() const
+{
+    return d_interval.isValid() ? d_interval : d_intervalOfInterest;
+}
+
+void QwtSyntheticPointData::updateCache( bool force )
+{
+    if ( !d_isCacheEnabled )
+    {
+        d_samples.clear();
+        d_cachedInterval.invalidate();
+
+        return;
+    }
+
+    const QwtInterval interval = effectiveInterval();
+
+    if ( !force && interval == d_cachedInterval
+        && static_cast<size_t>( d_samples.size() ) == d_size )
+    {
+        return;
+    }
+
+    // evaluating the function by copySamples() while 
+    // the cache is disabled
+
+    d_isCacheEnabled = false;
+
+    QVector<QPointF> samples( static_cast<int>( d_size ) );
+    copySamples( 0, d_size, samples.data() );
+
+    d_isCacheEnabled = true;
+
+    d_samples = samples;
+    d_cachedInterval = interval;
+
+    // the bounding rectangle is needed for autoscaling, 
+    // so we calculate it in advance
+
+    d_boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+    if ( interval.isValid() && d_size > 0 )
+    {
+        QwtPointSeriesData points( d_samples );
+        points.setBlockCopyEnabled( true );
+
+        d_boundingRect = points.boundingRect();
+    }
+}
+
 /*!
    Calculate a x-value from an index
 
@@ -293,8 +567,7 @@ QPointF QwtSyntheticPointData::sample( size_t index ) const
 */
 double QwtSyntheticPointData::x( uint index ) const
 {
-    const QwtInterval &interval = d_interval.isValid() ?
-        d_interval : d_intervalOfInterest;
+    const QwtInterval interval = effectiveInterval();
 
     if ( !interval.isValid() ) 
         return 0.0;
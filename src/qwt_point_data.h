@@ -15,6 +15,9 @@
 
 /*!
   \brief Interface for iterating over two QVector<double> objects.
+
+  copySamples() calls sample() for each sample, unless reading the
+  vectors directly has been enabled by setBlockCopyEnabled().
 */
 class QWT_EXPORT QwtPointArrayData: public QwtSeriesData<QPointF>
 {
@@ -26,17 +29,26 @@ public:
 
     virtual size_t size() const;
     virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
 
     const QVector<double> &xData() const;
     const QVector<double> &yData() const;
 
+    void setBlockCopyEnabled( bool on );
+    bool isBlockCopyEnabled() const;
+
 private:
     QVector<double> d_x;
     QVector<double> d_y;
+    bool d_blockCopyEnabled;
 };
 
 /*!
   \brief Data class containing two pointers to memory blocks of doubles.
+
+  copySamples() calls sample() for each sample, unless reading the
+  memory blocks directly has been enabled by setBlockCopyEnabled().
  */
 class QWT_EXPORT QwtCPointerData: public QwtSeriesData<QPointF>
 {
@@ -46,16 +58,321 @@ public:
     virtual QRectF boundingRect() const;
     virtual size_t size() const;
     virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
 
     const double *xData() const;
     const double *yData() const;
 
+    void setBlockCopyEnabled( bool on );
+    bool isBlockCopyEnabled() const;
+
 private:
     const double *d_x;
     const double *d_y;
     size_t d_size;
+    bool d_blockCopyEnabled;
 };
 
+/*!
+  \brief Data class containing two pointers to memory blocks of values
+         of an arbitrary numeric type
+
+  QwtTypedCPointerData allows to display samples of the type, 
+  they have been acquired or processed with - f.e. the 16 bit integers 
+  of an ADC or floats - without having to convert them into doubles
+  in advance. The values are converted, when reading them:
+
+  \code
+x = xFactor * xValue + xOffset
+y = yFactor * yValue + yOffset
+  \endcode
+
+  \par Example
+  \code
+// raw samples of a 12 bit ADC, read by an acquisition thread
+const qint16 *values = ...;
+
+QwtTypedCPointerData<qint16> *data = 
+    new QwtTypedCPointerData<qint16>( timeStamps, values, count );
+data->setYScale( 10.0 / 4096, -5.0 ); // volts
+
+curve->setData( data );
+  \endcode
+
+  \warning The programmer must assure that the memory blocks referenced
+           by the pointers remain valid during the lifetime of the
+           QwtTypedCPointerData object.
+
+  \sa QwtTypedPointArrayData, QwtCPointerData
+ */
+template <typename T>
+class QwtTypedCPointerData: public QwtSeriesData<QPointF>
+{
+public:
+    QwtTypedCPointerData( const T *x, const T *y, size_t size );
+
+    virtual QRectF boundingRect() const;
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    void setXScale( double factor, double offset = 0.0 );
+    double xFactor() const;
+    double xOffset() const;
+
+    void setYScale( double factor, double offset = 0.0 );
+    double yFactor() const;
+    double yOffset() const;
+
+    const T *xData() const;
+    const T *yData() const;
+
+protected:
+    void setValues( const T *x, const T *y, size_t size );
+
+private:
+    const T *d_x;
+    const T *d_y;
+    size_t d_size;
+
+    double d_xFactor;
+    double d_xOffset;
+    double d_yFactor;
+    double d_yOffset;
+};
+
+/*!
+  \brief Interface for iterating over two QVector objects of values
+         of an arbitrary numeric type
+
+  The same as QwtTypedCPointerData, but the values are stored in 
+  ( implicitly shared ) vectors.
+
+  \sa QwtTypedCPointerData, QwtPointArrayData
+ */
+template <typename T>
+class QwtTypedPointArrayData: public QwtTypedCPointerData<T>
+{
+public:
+    QwtTypedPointArrayData( const QVector<T> &x, const QVector<T> &y );
+
+    const QVector<T> &xVector() const;
+    const QVector<T> &yVector() const;
+
+private:
+    const QVector<T> d_xVector;
+    const QVector<T> d_yVector;
+};
+
+/*!
+  Constructor
+
+  The values are taken as they are: all factors are 1.0 
+  and all offsets are 0.0.
+
+  \param x Array of x values
+  \param y Array of y values
+  \param size Size of the x and y arrays
+
+  \sa setXScale(), setYScale()
+*/
+template <typename T>
+QwtTypedCPointerData<T>::QwtTypedCPointerData(
+        const T *x, const T *y, size_t size ):
+    d_x( x ),
+    d_y( y ),
+    d_size( size ),
+    d_xFactor( 1.0 ),
+    d_xOffset( 0.0 ),
+    d_yFactor( 1.0 ),
+    d_yOffset( 0.0 )
+{
+}
+
+//! Change the arrays, the samples are read from
+template <typename T>
+void QwtTypedCPointerData<T>::setValues( 
+    const T *x, const T *y, size_t size )
+{
+    d_x = x;
+    d_y = y;
+    d_size = size;
+
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+  \brief Calculate the bounding rectangle
+
+  The bounding rectangle is calculated once by iterating over all
+  points and is stored for all following requests.
+
+  \return Bounding rectangle
+*/
+template <typename T>
+QRectF QwtTypedCPointerData<T>::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0 )
+        d_boundingRect = qwtBoundingRect( *this );
+
+    return d_boundingRect;
+}
+
+//! \return Size of the data set
+template <typename T>
+size_t QwtTypedCPointerData<T>::size() const
+{
+    return d_size;
+}
+
+/*!
+  Return the sample at position i
+
+  \param index Index
+  \return Sample at position i
+*/
+template <typename T>
+QPointF QwtTypedCPointerData<T>::sample( size_t index ) const
+{
+    return QPointF( d_xFactor * d_x[index] + d_xOffset,
+        d_yFactor * d_y[index] + d_yOffset );
+}
+
+/*!
+  Convert a block of samples into a buffer
+
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+*/
+template <typename T>
+void QwtTypedCPointerData<T>::copySamples(
+    size_t from, size_t count, QPointF *samples ) const
+{
+    const T *x = d_x + from;
+    const T *y = d_y + from;
+
+    const double xFactor = d_xFactor;
+    const double xOffset = d_xOffset;
+    const double yFactor = d_yFactor;
+    const double yOffset = d_yOffset;
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        samples[i].rx() = xFactor * x[i] + xOffset;
+        samples[i].ry() = yFactor * y[i] + yOffset;
+    }
+}
+
+/*!
+  \brief Set the conversion of the x values
+
+  \param factor Factor, the values are multiplied with
+  \param offset Offset, that is added after multiplying
+
+  \sa xFactor(), xOffset(), setYScale()
+*/
+template <typename T>
+void QwtTypedCPointerData<T>::setXScale( double factor, double offset )
+{
+    d_xFactor = factor;
+    d_xOffset = offset;
+
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+//! \return Factor for the x values
+template <typename T>
+double QwtTypedCPointerData<T>::xFactor() const
+{
+    return d_xFactor;
+}
+
+//! \return Offset for the x values
+template <typename T>
+double QwtTypedCPointerData<T>::xOffset() const
+{
+    return d_xOffset;
+}
+
+/*!
+  \brief Set the conversion of the y values
+
+  \param factor Factor, the values are multiplied with
+  \param offset Offset, that is added after multiplying
+
+  \sa yFactor(), yOffset(), setXScale()
+*/
+template <typename T>
+void QwtTypedCPointerData<T>::setYScale( double factor, double offset )
+{
+    d_yFactor = factor;
+    d_yOffset = offset;
+
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+//! \return Factor for the y values
+template <typename T>
+double QwtTypedCPointerData<T>::yFactor() const
+{
+    return d_yFactor;
+}
+
+//! \return Offset for the y values
+template <typename T>
+double QwtTypedCPointerData<T>::yOffset() const
+{
+    return d_yOffset;
+}
+
+//! \return Array of the raw x-values
+template <typename T>
+const T *QwtTypedCPointerData<T>::xData() const
+{
+    return d_x;
+}
+
+//! \return Array of the raw y-values
+template <typename T>
+const T *QwtTypedCPointerData<T>::yData() const
+{
+    return d_y;
+}
+
+/*!
+  Constructor
+
+  \param x Array of x values
+  \param y Array of y values
+*/
+template <typename T>
+QwtTypedPointArrayData<T>::QwtTypedPointArrayData(
+        const QVector<T> &x, const QVector<T> &y ):
+    QwtTypedCPointerData<T>( NULL, NULL, 0 ),
+    d_xVector( x ),
+    d_yVector( y )
+{
+    this->setValues( d_xVector.constData(), d_yVector.constData(),
+        qMin( d_xVector.size(), d_yVector.size() ) );
+}
+
+//! \return Vector of the raw x-values
+template <typename T>
+const QVector<T> &QwtTypedPointArrayData<T>::xVector() const
+{
+    return d_xVector;
+}
+
+//! \return Vector of the raw y-values
+template <typename T>
+const QVector<T> &QwtTypedPointArrayData<T>::yVector() const
+{
+    return d_yVector;
+}
+
 /*!
   \brief Synthetic point data
 
@@ -67,6 +384,21 @@ private:
   plot canvas. In this mode you get different levels of detail, when
   zooming in/out.
 
+  The points are calculated, whenever they are accessed: sample()
+  calls y() for a single point, while copySamples() - used for painting
+  and calculating the bounding rectangle - passes blocks of x values 
+  to yValues(). Functions, that can be evaluated faster for an array 
+  of values ( f.e. using SIMD instructions ), can reimplement yValues().
+
+  For expensive functions, that don't change, the points can be 
+  cached ( setCacheEnabled() ). Then all points are calculated at once,
+  when the number of points or the interval, they are calculated for, 
+  changes.
+
+  \warning When caching is enabled, the points of a function depending 
+           on some changing state ( f.e. an animation ) are not updated
+           before invalidateCache() has been called.
+
   \par Example
 
   The following example shows how to implement a sinus curve.
@@ -133,14 +465,32 @@ public:
     virtual double y( double x ) const = 0;
     virtual double x( uint index ) const;
 
+    virtual void yValues( const double *xValues,
+        double *yValues, size_t count ) const;
+
     virtual void setRectOfInterest( const QRectF & );
     QRectF rectOfInterest() const;
 
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    void setCacheEnabled( bool on );
+    bool isCacheEnabled() const;
+
+    void invalidateCache();
+
 private:
+    QwtInterval effectiveInterval() const;
+    void updateCache( bool force );
+
     size_t d_size;
     QwtInterval d_interval;
     QRectF d_rectOfInterest;
     QwtInterval d_intervalOfInterest;
+
+    bool d_isCacheEnabled;
+    QwtInterval d_cachedInterval;
+    QVector<QPointF> d_samples;
 };
 
 #endif
@@ -10,6 +10,8 @@
 #include "qwt_point_mapper.h"
 #include "qwt_scale_map.h"
 #include "qwt_pixel_matrix.h"
+#include "qwt_math.h"
+#include "qwt_clipper.h"
 #include <qpolygon.h>
 #include <qimage.h>
 #include <qpen.h>
@@ -20,7 +22,7 @@
 #include <qtconcurrentrun.h>
 
 #if !defined(QT_NO_QFUTURE)
-#define QWT_USE_THREADS 0
+#define QWT_USE_THREADS 1
 #endif
 
 static QRectF qwtInvalidRect( 0.0, 0.0, -1.0, -1.0 );
@@ -74,6 +76,68 @@ static Qt::Orientation qwtProbeOrientation(
     return Qt::Horizontal;
 }
 
+// Reading blocks of samples and translating them into paint device
+// coordinates using the array transformations of QwtScaleMap
+
+class QwtMappedSeriesReader
+{
+public:
+    enum { BufferSize = 256 };
+
+    QwtMappedSeriesReader( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+            const QwtSeriesData<QPointF> &series, int from, int to ):
+        d_xMap( xMap ),
+        d_yMap( yMap ),
+        d_series( series ),
+        d_index( from ),
+        d_to( to ),
+        d_pos( 0 ),
+        d_count( 0 )
+    {
+    }
+
+    inline bool hasNext() const
+    {
+        return ( d_pos < d_count ) || ( d_index <= d_to );
+    }
+
+    inline const QPointF &next()
+    {
+        if ( d_pos == d_count )
+            fetch();
+
+        return d_buffer[ d_pos++ ];
+    }
+
+private:
+    void fetch()
+    {
+        d_count = qMin( static_cast<int>( BufferSize ), d_to - d_index + 1 );
+
+        if ( !d_series.copyMappedSamples( d_xMap, d_yMap, 
+            d_index, d_count, d_buffer ) )
+        {
+            d_series.copySamples( d_index, d_count, d_buffer );
+            QwtScaleMap::transform( d_xMap, d_yMap, d_buffer, d_buffer, d_count );
+        }
+
+        d_index += d_count;
+        d_pos = 0;
+    }
+
+    const QwtScaleMap &d_xMap;
+    const QwtScaleMap &d_yMap;
+    const QwtSeriesData<QPointF> &d_series;
+
+    int d_index;
+    const int d_to;
+
+    int d_pos;
+    int d_count;
+
+    QPointF d_buffer[ BufferSize ];
+};
+
 template <class Polygon, class Point>
 class QwtPolygonQuadrupelX
 {
@@ -188,12 +252,14 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap &xMap, const QwtScaleMap &yMa
         qwtRoundValue( yMap.transform( sample0.y() ) ) );
 
     Polygon polyline;
-    for ( int i = from; i <= to; i++ )
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+    while ( reader.hasNext() )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF &pos = reader.next();
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
 
         if ( !q.append( x, y ) )
         {
@@ -281,8 +347,177 @@ public:
     int from;
     int to;
     QRgb rgb;
+
+    // only needed for pens wider than one pixel
+    double radius;
+    bool round;
+    bool antialiased;
+    double opacity;
+
+    // band of rows, that is painted
+    int rowFrom;
+    int rowTo;
+};
+
+/*
+  All dots are painted with the same color. So the result of
+  alpha blending them - in whatever order - is a pixel of this color
+  with an opacity of 1 - T, where T is the product of the
+  transmittances ( 1 - opacity * coverage ) of all dots
+  covering the pixel.
+ */
+class QwtTransmittanceBuffer
+{
+public:
+    QwtTransmittanceBuffer( int w, int h ):
+        width( w ),
+        height( h ),
+        values( w * h, 1.0f )
+    {
+    }
+
+    int width;
+    int height;
+    QVector<float> values;
+};
+
+class QwtPixelSetter
+{
+public:
+    QwtPixelSetter( QImage *image, QRgb rgb ):
+        d_bits( reinterpret_cast<QRgb *>( image->bits() ) ),
+        d_rgb( rgb )
+    {
+    }
+
+    inline void operator()( int index, double ) const
+    {
+        d_bits[ index ] = d_rgb;
+    }
+
+private:
+    QRgb *d_bits;
+    const QRgb d_rgb;
 };
 
+class QwtPixelAttenuator
+{
+public:
+    QwtPixelAttenuator( QwtTransmittanceBuffer *buffer, double opacity ):
+        d_values( buffer->values.data() ),
+        d_opacity( opacity )
+    {
+    }
+
+    inline void operator()( int index, double coverage ) const
+    {
+        d_values[ index ] *= static_cast<float>( 1.0 - d_opacity * coverage );
+    }
+
+private:
+    float *d_values;
+    const double d_opacity;
+};
+
+static inline double qwtOverlap( double a1, double a2, double b1, double b2 )
+{
+    return qMax( 0.0, qMin( a2, b2 ) - qMax( a1, b1 ) );
+}
+
+/*
+  Paint a dot with the footprint of a pen. The center of pixel (i, j) 
+  is at (i, j) - like in qwtRenderDots(). The coverage of a pixel is the area
+  of its intersection with a square pen, or it is approximated from 
+  the distance to the center for round pens.
+ */
+template <class PixelOperation>
+static inline void qwtRenderPenDot( double x, double y, 
+    const QwtDotsCommand &command, int w, int h, 
+    const PixelOperation &pixelOperation )
+{
+    const double r = command.radius;
+
+    if ( x + r < -1.0 || x - r > w 
+        || y + r < command.rowFrom - 1 || y - r > command.rowTo + 1 )
+    {
+        return;
+    }
+
+    int x1, x2, y1, y2;
+    if ( command.antialiased )
+    {
+        x1 = qCeil( x - r - 0.5 );
+        x2 = qFloor( x + r + 0.5 );
+        y1 = qCeil( y - r - 0.5 );
+        y2 = qFloor( y + r + 0.5 );
+    }
+    else
+    {
+        x1 = qFloor( x - r ) + 1;
+        x2 = qFloor( x + r );
+        y1 = qFloor( y - r ) + 1;
+        y2 = qFloor( y + r );
+    }
+
+    x1 = qMax( x1, 0 );
+    x2 = qMin( x2, w - 1 );
+    y1 = qMax( y1, qMax( command.rowFrom, 0 ) );
+    y2 = qMin( y2, qMin( command.rowTo, h - 1 ) );
+
+    if ( !command.round )
+    {
+        for ( int j = y1; j <= y2; j++ )
+        {
+            double cy = 1.0;
+            if ( command.antialiased )
+                cy = qwtOverlap( j - 0.5, j + 0.5, y - r, y + r );
+
+            for ( int i = x1; i <= x2; i++ )
+            {
+                double coverage = cy;
+                if ( command.antialiased )
+                    coverage *= qwtOverlap( i - 0.5, i + 0.5, x - r, x + r );
+
+                if ( coverage > 0.0 )
+                    pixelOperation( j * w + i, coverage );
+            }
+        }
+
+        return;
+    }
+
+    // the pixel including the center is always painted
+    const int cx = qFloor( x + 0.5 );
+    const int cy = qFloor( y + 0.5 );
+
+    // dots smaller than a pixel can't cover more than their area
+    const double maxCoverage = qMin( 1.0, M_PI * r * r );
+
+    for ( int j = y1; j <= y2; j++ )
+    {
+        const double dy = j - y;
+        for ( int i = x1; i <= x2; i++ )
+        {
+            const double dx = i - x;
+            const double d2 = dx * dx + dy * dy;
+
+            if ( command.antialiased )
+            {
+                const double coverage = 
+                    qBound( 0.0, r + 0.5 - qSqrt( d2 ), maxCoverage );
+
+                if ( coverage > 0.0 )
+                    pixelOperation( j * w + i, coverage );
+            }
+            else
+            {
+                if ( d2 < r * r || ( i == cx && j == cy ) )
+                    pixelOperation( j * w + i, 1.0 );
+            }
+        }
+    }
+}
+
 static void qwtRenderDots(
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
     const QwtDotsCommand command, const QPoint &pos, QImage *image ) 
@@ -296,18 +531,58 @@ static void qwtRenderDots(
     const int x0 = pos.x();
     const int y0 = pos.y();
 
-    for ( int i = command.from; i <= command.to; i++ )
+    QwtMappedSeriesReader reader( xMap, yMap,
+        *command.series, command.from, command.to );
+    while ( reader.hasNext() )
     {
-        const QPointF sample = command.series->sample( i );
+        const QPointF &mapped = reader.next();
 
-        const int x = static_cast<int>( xMap.transform( sample.x() ) + 0.5 ) - x0;
-        const int y = static_cast<int>( yMap.transform( sample.y() ) + 0.5 ) - y0;
+        const int x = static_cast<int>( mapped.x() + 0.5 ) - x0;
+        const int y = static_cast<int>( mapped.y() + 0.5 ) - y0;
 
         if ( x >= 0 && x < w && y >= 0 && y < h )
             bits[ y * w + x ] = rgb;
     }
 }
 
+static void qwtRenderPenDots(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtDotsCommand command, const QPoint &pos, QImage *image ) 
+{
+    const QwtPixelSetter pixelSetter( image, command.rgb );
+
+    const int w = image->width();
+    const int h = image->height();
+
+    QwtMappedSeriesReader reader( xMap, yMap,
+        *command.series, command.from, command.to );
+    while ( reader.hasNext() )
+    {
+        const QPointF &mapped = reader.next();
+
+        qwtRenderPenDot( mapped.x() - pos.x(), mapped.y() - pos.y(), 
+            command, w, h, pixelSetter );
+    }
+}
+
+static void qwtRenderPenDotsAttenuated(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtDotsCommand command, const QPoint &pos, 
+    QwtTransmittanceBuffer *buffer )
+{
+    const QwtPixelAttenuator attenuator( buffer, command.opacity );
+
+    QwtMappedSeriesReader reader( xMap, yMap,
+        *command.series, command.from, command.to );
+    while ( reader.hasNext() )
+    {
+        const QPointF &mapped = reader.next();
+
+        qwtRenderPenDot( mapped.x() - pos.x(), mapped.y() - pos.y(), 
+            command, buffer->width, buffer->height, attenuator );
+    }
+}
+
 // some functors, so that the compile can inline
 struct QwtRoundI
 {
@@ -333,6 +608,166 @@ struct QwtNoRoundF
     }
 };
 
+// mapping the corners of a step function
+
+template<class Round>
+static QPolygonF qwtMapSteps( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, 
+    bool inverted, Round round )
+{
+    QPolygonF polyline( 2 * ( to - from ) + 1 );
+    QPointF *points = polyline.data();
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+
+    const QPointF &pos0 = reader.next();
+    points[0] = QPointF( round( pos0.x() ), round( pos0.y() ) );
+
+    for ( int i = 2; reader.hasNext(); i += 2 )
+    {
+        const QPointF &pos = reader.next();
+
+        QPointF &p = points[i];
+        p.rx() = round( pos.x() );
+        p.ry() = round( pos.y() );
+
+        const QPointF &p0 = points[i - 2];
+        if ( inverted )
+            points[i - 1] = QPointF( p0.x(), p.y() );
+        else
+            points[i - 1] = QPointF( p.x(), p0.y() );
+    }
+
+    return polyline;
+}
+
+/*
+  Mapping the corners of a step function, reducing each chunk
+  of consecutive corners in the same pixel column to 4 points. 
+  As all lines of such a chunk are vertical lines in the same
+  column the reduced polyline covers the same pixels.
+ */
+static QPolygonF qwtMapStepsQuad( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, bool inverted )
+{
+    QPolygonF polyline;
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+
+    const QPointF &pos0 = reader.next();
+
+    int x0 = qwtRoundValue( pos0.x() );
+    int y0 = qwtRoundValue( pos0.y() );
+
+    QwtPolygonQuadrupelX<QPolygonF, QPointF> q;
+    q.start( x0, y0 );
+
+    while ( reader.hasNext() )
+    {
+        const QPointF &pos = reader.next();
+
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
+
+        const int cx = inverted ? x0 : x;
+        const int cy = inverted ? y : y0;
+
+        if ( !q.append( cx, cy ) )
+        {
+            q.flush( polyline );
+            q.start( cx, cy );
+        }
+
+        if ( !q.append( x, y ) )
+        {
+            q.flush( polyline );
+            q.start( x, y );
+        }
+
+        x0 = x;
+        y0 = y;
+    }
+    q.flush( polyline );
+
+    // the same for horizontal lines in the same pixel row
+
+    return qwtMapPointsQuad< QPolygonF, QPointF, 
+        QwtPolygonQuadrupelY<QPolygonF, QPointF> >( polyline );
+}
+
+/*
+  Mapping the end points of sticks. Consecutive sticks in the
+  same pixel column ( row ) are reduced to the shortest and the longest 
+  one in both directions. As all sticks start at the baseline those two 
+  cover the same pixels as all of them.
+ */
+static QPolygonF qwtMapSticksReduced( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, 
+    Qt::Orientation orientation )
+{
+    const bool vertical = ( orientation == Qt::Vertical );
+
+    QPolygonF points;
+
+    int column = 0;
+    int minValue = 0;
+    int maxValue = -1;
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+    while ( reader.hasNext() )
+    {
+        const QPointF &pos = reader.next();
+
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
+
+        const int c = vertical ? x : y;
+        const int v = vertical ? y : x;
+
+        if ( c == column && minValue <= maxValue )
+        {
+            if ( v < minValue )
+                minValue = v;
+            else if ( v > maxValue )
+                maxValue = v;
+
+            continue;
+        }
+
+        if ( minValue <= maxValue )
+        {
+            points += vertical 
+                ? QPointF( column, minValue ) : QPointF( minValue, column );
+
+            if ( maxValue != minValue )
+            {
+                points += vertical 
+                    ? QPointF( column, maxValue ) : QPointF( maxValue, column );
+            }
+        }
+
+        column = c;
+        minValue = maxValue = v;
+    }
+
+    if ( minValue <= maxValue )
+    {
+        points += vertical 
+            ? QPointF( column, minValue ) : QPointF( minValue, column );
+
+        if ( maxValue != minValue )
+        {
+            points += vertical 
+                ? QPointF( column, maxValue ) : QPointF( maxValue, column );
+        }
+    }
+
+    return points;
+}
+
 // mapping points without any filtering - beside checking
 // the bounding rectangle
 
@@ -354,12 +789,13 @@ static inline Polygon qwtToPoints(
         // filtering out all points outside of
         // the bounding rectangle
 
-        for ( int i = from; i <= to; i++ )
+        QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+        while ( reader.hasNext() )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF &pos = reader.next();
 
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            const double x = pos.x();
+            const double y = pos.y();
 
             if ( boundingRect.contains( x, y ) )
             {
@@ -377,12 +813,13 @@ static inline Polygon qwtToPoints(
         // simply iterating over all values
         // without any filtering
 
-        for ( int i = from; i <= to; i++ )
+        QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+        while ( reader.hasNext() )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF &pos = reader.next();
 
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            const double x = pos.x();
+            const double y = pos.y();
 
             points[ numPoints ].rx() = round( x );
             points[ numPoints ].ry() = round( y );
@@ -432,18 +869,19 @@ static inline Polygon qwtToPolylineFiltered(
     Polygon polyline( to - from + 1 );
     Point *points = polyline.data();
 
-    const QPointF sample0 = series->sample( from );
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
 
-    points[0].rx() = round( xMap.transform( sample0.x() ) );
-    points[0].ry() = round( yMap.transform( sample0.y() ) );
+    const QPointF pos0 = reader.next();
+
+    points[0].rx() = round( pos0.x() );
+    points[0].ry() = round( pos0.y() );
 
     int pos = 0;
-    for ( int i = from + 1; i <= to; i++ )
+    while ( reader.hasNext() )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF &mapped = reader.next();
 
-        const Point p( round( xMap.transform( sample.x() ) ),
-            round( yMap.transform( sample.y() ) ) );
+        const Point p( round( mapped.x() ), round( mapped.y() ) );
 
         if ( points[pos] != p )
             points[++pos] = p;
@@ -472,69 +910,663 @@ static inline QPolygonF qwtToPolylineFilteredF(
         xMap, yMap, series, from, to, round );
 } 
 
-template<class Polygon, class Point>
-static inline Polygon qwtToPointsFiltered(
-    const QRectF &boundingRect,
-    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-    const QwtSeriesData<QPointF> *series, int from, int to )
-{
-    // F.e. in scatter plots ( no connecting lines ) we
-    // can sort out all duplicates ( not only consecutive points )
-
-    Polygon polygon( to - from + 1 );
-    Point *points = polygon.data();
+/*
+  Clipping a polyline against a rectangle segment by segment 
+  ( Liang-Barsky ) while the points are appended. 
 
-    QwtPixelMatrix pixelMatrix( boundingRect.toAlignedRect() );
+  Each run of points outside of the rectangle is replaced by the 
+  point, where the polyline leaves the rectangle, the point, where 
+  it enters again, and the corners in between ( at most 2 ). 
+  So the parts inside are exactly the same, while the lines 
+  between the runs are on the border of the rectangle.
 
-    int numPoints = 0;
-    for ( int i = from; i <= to; i++ )
+  When collecting the runs the polyline is split instead.
+ */
+class QwtClippedPolyline
+{
+public:
+    QwtClippedPolyline( const QRectF &rect, QPolygonF &polyline,
+            QVector<QPolygonF> *runs = NULL ):
+        d_rect( rect ),
+        d_polyline( polyline ),
+        d_runs( runs ),
+        d_isEmpty( true ),
+        d_isInside( false )
     {
-        const QPointF sample = series->sample( i );
+    }
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+    inline void flush()
+    {
+        if ( d_runs && !d_polyline.isEmpty() )
+        {
+            *d_runs += d_polyline;
+            d_polyline.clear();
+        }
+    }
 
-        if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+    inline void append( const QPointF &pos )
+    {
+        if ( d_isEmpty )
         {
-            points[ numPoints ].rx() = x;
-            points[ numPoints ].ry() = y;
+            d_isEmpty = false;
+            d_isInside = contains( pos );
 
-            numPoints++;
+            if ( d_isInside )
+                d_polyline += pos;
+        }
+        else if ( d_isInside && contains( pos ) )
+        {
+            d_polyline += pos;
+        }
+        else
+        {
+            appendClipped( pos );
         }
+
+        d_pos = pos;
     }
 
-    polygon.resize( numPoints );
-    return polygon;
-}
+private:
+    inline bool contains( const QPointF &pos ) const
+    {
+        return pos.x() >= d_rect.left() && pos.x() <= d_rect.right()
+            && pos.y() >= d_rect.top() && pos.y() <= d_rect.bottom();
+    }
 
-static inline QPolygon qwtToPointsFilteredI(
-    const QRectF &boundingRect,
-    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-    const QwtSeriesData<QPointF> *series, int from, int to )
-{
-    return qwtToPointsFiltered<QPolygon, QPoint>(
-        boundingRect, xMap, yMap, series, from, to );
-} 
+    void appendClipped( const QPointF &pos )
+    {
+        const double dx = pos.x() - d_pos.x();
+        const double dy = pos.y() - d_pos.y();
 
-static inline QPolygonF qwtToPointsFilteredF(
-    const QRectF &boundingRect,
-    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-    const QwtSeriesData<QPointF> *series, int from, int to )
-{
-    return qwtToPointsFiltered<QPolygonF, QPointF>(
+        double t0, t1;
+        if ( !QwtClipper::clipLine( d_rect, d_pos, pos, t0, t1 ) )
+        {
+            // the line is completely outside
+            d_isInside = false;
+            return;
+        }
+
+        if ( t0 > 0.0 )
+        {
+            // entering the rectangle
+
+            const QPointF p1( d_pos.x() + t0 * dx, d_pos.y() + t0 * dy );
+
+            if ( d_runs )
+                flush();
+            else if ( !d_polyline.isEmpty() )
+                appendCorners( d_polyline.last(), p1 );
+
+            appendPoint( p1 );
+        }
+
+        if ( t1 < 1.0 )
+        {
+            // leaving the rectangle
+
+            appendPoint( QPointF( d_pos.x() + t1 * dx, d_pos.y() + t1 * dy ) );
+            d_isInside = false;
+        }
+        else
+        {
+            appendPoint( pos );
+            d_isInside = true;
+        }
+    }
+
+    inline void appendPoint( const QPointF &pos )
+    {
+        if ( d_polyline.isEmpty() || d_polyline.last() != pos )
+            d_polyline += pos;
+    }
+
+    // position of a point on the border: clockwise from the top left corner
+    double borderPosition( const QPointF &pos ) const
+    {
+        const double w = d_rect.width();
+        const double h = d_rect.height();
+
+        const double dl = qAbs( pos.x() - d_rect.left() );
+        const double dr = qAbs( pos.x() - d_rect.right() );
+        const double dt = qAbs( pos.y() - d_rect.top() );
+        const double db = qAbs( pos.y() - d_rect.bottom() );
+
+        const double d = qMin( qMin( dl, dr ), qMin( dt, db ) );
+
+        if ( d == dt )
+            return pos.x() - d_rect.left();
+
+        if ( d == dr )
+            return w + pos.y() - d_rect.top();
+
+        if ( d == db )
+            return w + h + d_rect.right() - pos.x();
+
+        return 2 * w + h + d_rect.bottom() - pos.y();
+    }
+
+    // connecting 2 points on the border along the shorter way 
+
+    void appendCorners( const QPointF &pos1, const QPointF &pos2 )
+    {
+        const double w = d_rect.width();
+        const double h = d_rect.height();
+        const double length = 2 * ( w + h );
+
+        const QPointF corners[] = { d_rect.topLeft(), d_rect.topRight(), 
+            d_rect.bottomRight(), d_rect.bottomLeft() };
+        const double positions[] = { 0.0, w, w + h, 2 * w + h };
+
+        const double s1 = borderPosition( pos1 );
+        const double s2 = borderPosition( pos2 );
+
+        double distance = s2 - s1;
+        if ( distance < 0.0 )
+            distance += length;
+
+        const bool clockwise = ( distance <= 0.5 * length );
+        if ( !clockwise )
+            distance = length - distance;
+
+        int indices[2];
+        double offsets[2];
+        int numCorners = 0;
+
+        for ( int i = 0; i < 4 && numCorners < 2; i++ )
+        {
+            double offset = clockwise 
+                ? positions[i] - s1 : s1 - positions[i];
+
+            if ( offset < 0.0 )
+                offset += length;
+
+            if ( offset > 0.0 && offset < distance )
+            {
+                indices[numCorners] = i;
+                offsets[numCorners] = offset;
+                numCorners++;
+            }
+        }
+
+        if ( numCorners == 2 && offsets[1] < offsets[0] )
+            qSwap( indices[0], indices[1] );
+
+        for ( int i = 0; i < numCorners; i++ )
+            appendPoint( corners[ indices[i] ] );
+    }
+
+    const QRectF d_rect;
+    QPolygonF &d_polyline;
+    QVector<QPolygonF> *d_runs;
+
+    QPointF d_pos;
+    bool d_isEmpty;
+    bool d_isInside;
+};
+
+static QPolygonF qwtClipPolyline( const QRectF &rect, 
+    const QPolygonF &polyline, QVector<QPolygonF> *runs = NULL )
+{
+    QPolygonF clipped;
+
+    QwtClippedPolyline clipper( rect, clipped, runs );
+    for ( int i = 0; i < polyline.size(); i++ )
+        clipper.append( polyline[i] );
+
+    clipper.flush();
+
+    return clipped;
+}
+
+// Mapping, weeding and clipping in one pass without 
+// any intermediate polygon
+
+template<class Round>
+static QPolygonF qwtToPolylineClipped( const QRectF &clipRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, 
+    int from, int to, bool weedOut, Round round,
+    QVector<QPolygonF> *runs = NULL )
+{
+    QPolygonF polyline;
+    QwtClippedPolyline clipper( clipRect, polyline, runs );
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+
+    const QPointF &pos0 = reader.next();
+
+    QPointF p0( round( pos0.x() ), round( pos0.y() ) );
+    clipper.append( p0 );
+
+    while ( reader.hasNext() )
+    {
+        const QPointF &mapped = reader.next();
+
+        const QPointF p( round( mapped.x() ), round( mapped.y() ) );
+        if ( !weedOut || p != p0 )
+        {
+            clipper.append( p );
+            p0 = p;
+        }
+    }
+
+    clipper.flush();
+
+    return polyline;
+}
+
+template<class Polygon, class Point>
+static inline Polygon qwtToPointsFiltered(
+    const QRectF &boundingRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to )
+{
+    // F.e. in scatter plots ( no connecting lines ) we
+    // can sort out all duplicates ( not only consecutive points )
+
+    Polygon polygon( to - from + 1 );
+    Point *points = polygon.data();
+
+    QwtPixelMatrix pixelMatrix( boundingRect.toAlignedRect() );
+
+    int numPoints = 0;
+
+    QwtMappedSeriesReader reader( xMap, yMap, *series, from, to );
+    while ( reader.hasNext() )
+    {
+        const QPointF &pos = reader.next();
+
+        const int x = qwtRoundValue( pos.x() );
+        const int y = qwtRoundValue( pos.y() );
+
+        if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+        {
+            points[ numPoints ].rx() = x;
+            points[ numPoints ].ry() = y;
+
+            numPoints++;
+        }
+    }
+
+    polygon.resize( numPoints );
+    return polygon;
+}
+
+static inline QPolygon qwtToPointsFilteredI(
+    const QRectF &boundingRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to )
+{
+    return qwtToPointsFiltered<QPolygon, QPoint>(
+        boundingRect, xMap, yMap, series, from, to );
+} 
+
+static inline QPolygonF qwtToPointsFilteredF(
+    const QRectF &boundingRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to )
+{
+    return qwtToPointsFiltered<QPolygonF, QPointF>(
         boundingRect, xMap, yMap, series, from, to );
 }
 
+#if QWT_USE_THREADS
+
+/*
+  Mapping in parallel threads: the index range is split into chunks,
+  that are processed by the same algorithms as in the single threaded
+  code. The results are stitched together, so that they are identical
+  to the ones of the single threaded code.
+ */
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtMapCommand
+{
+public:
+    const QwtScaleMap *xMap;
+    const QwtScaleMap *yMap;
+    const QwtSeriesData<QPointF> *series;
+    QRectF boundingRect;
+    int from;
+    int to;
+};
+
+template<class Polygon, class Point, class Round>
+static void qwtMapPointsChunk( const QwtMapCommand command, Polygon *points )
+{
+    *points = qwtToPoints<Polygon, Point>( command.boundingRect,
+        *command.xMap, *command.yMap, command.series,
+        command.from, command.to, Round() );
+}
+
+template<class Polygon, class Point, class Round>
+static void qwtMapPolylineFilteredChunk( 
+    const QwtMapCommand command, Polygon *polyline )
+{
+    *polyline = qwtToPolylineFiltered<Polygon, Point>(
+        *command.xMap, *command.yMap, command.series,
+        command.from, command.to, Round() );
+}
+
+static uint qwtThreadCount( uint numThreads, int numPoints )
+{
+    // below this number of points per thread the overhead
+    // for starting the threads is not worth it
+    const int minChunkSize = 10000;
+
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, uint( numPoints / minChunkSize ) );
+
+    return qMax( numThreads, 1u );
+}
+
+template<class Polygon>
+static QVector<Polygon> qwtMapChunks( 
+    void ( *mapChunk )( const QwtMapCommand, Polygon * ),
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap, 
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    const QRectF &boundingRect, uint numThreads )
+{
+    QVector<Polygon> chunks( numThreads );
+
+    QwtMapCommand command;
+    command.xMap = &xMap;
+    command.yMap = &yMap;
+    command.series = series;
+    command.boundingRect = boundingRect;
+
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+    QList< QFuture<void> > futures;
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        command.from = from + i * numPoints;
+
+        if ( i == numThreads - 1 )
+        {
+            command.to = to;
+            mapChunk( command, &chunks[i] );
+        }
+        else
+        {
+            command.to = command.from + numPoints - 1;
+            futures += QtConcurrent::run( mapChunk, command, &chunks[i] );
+        }
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+
+    return chunks;
+}
+
+template<class Polygon>
+static Polygon qwtJoinChunks( const QVector<Polygon> &chunks, bool weedOut )
+{
+    int numPoints = 0;
+    for ( int i = 0; i < chunks.size(); i++ )
+        numPoints += chunks[i].size();
+
+    Polygon polyline( numPoints );
+
+    int pos = 0;
+    for ( int i = 0; i < chunks.size(); i++ )
+    {
+        const Polygon &chunk = chunks[i];
+
+        int j = 0;
+
+        // the first point of a chunk might be a duplicate
+        // of the last point of the previous chunk
+
+        if ( weedOut && pos > 0 && chunk.size() > 0 
+            && chunk[0] == polyline[pos - 1] )
+        {
+            j++;
+        }
+
+        for ( ; j < chunk.size(); j++ )
+            polyline[pos++] = chunk[j];
+    }
+
+    polyline.resize( pos );
+    return polyline;
+}
+
+template<class Polygon, class Point, class Round>
+static Polygon qwtToPointsMT( const QRectF &boundingRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, 
+    Round, uint numThreads )
+{
+    const QVector<Polygon> chunks = qwtMapChunks<Polygon>( 
+        &qwtMapPointsChunk<Polygon, Point, Round>,
+        xMap, yMap, series, from, to, boundingRect, numThreads );
+
+    return qwtJoinChunks( chunks, false );
+}
+
+template<class Polygon, class Point, class Round>
+static Polygon qwtToPolylineFilteredMT(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, 
+    Round, uint numThreads )
+{
+    const QVector<Polygon> chunks = qwtMapChunks<Polygon>( 
+        &qwtMapPolylineFilteredChunk<Polygon, Point, Round>,
+        xMap, yMap, series, from, to, qwtInvalidRect, numThreads );
+
+    return qwtJoinChunks( chunks, true );
+}
+
+template<class Polygon, class Point>
+static Polygon qwtMapPointsQuadMT( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    uint numThreads )
+{
+    /*
+      Removing consecutive duplicates doesn't change the result of
+      the quadrupel algorithm. So we can map the points in parallel
+      and run the - much cheaper - weeding on the result.
+     */
+
+    QPolygon points = qwtToPolylineFilteredMT<QPolygon, QPoint>( 
+        xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+
+    const Qt::Orientation orientation = qwtProbeOrientation( series, from, to );
+
+    if ( orientation == Qt::Horizontal )
+    {
+        points = qwtMapPointsQuad< QPolygon, QPoint,
+            QwtPolygonQuadrupelY<QPolygon, QPoint> >( points );
+
+        points = qwtMapPointsQuad< QPolygon, QPoint,
+            QwtPolygonQuadrupelX<QPolygon, QPoint> >( points );
+    }
+    else
+    {
+        points = qwtMapPointsQuad< QPolygon, QPoint,
+            QwtPolygonQuadrupelX<QPolygon, QPoint> >( points );
+
+        points = qwtMapPointsQuad< QPolygon, QPoint,
+            QwtPolygonQuadrupelY<QPolygon, QPoint> >( points );
+    }
+
+    Polygon polyline( points.size() );
+    for ( int i = 0; i < points.size(); i++ )
+        polyline[i] = Point( points[i].x(), points[i].y() );
+
+    return polyline;
+}
+
+template<class Polygon, class Point>
+static Polygon qwtToPointsFilteredMT( const QRectF &boundingRect,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    uint numThreads )
+{
+    // mapping in parallel, filtering the duplicates afterwards
+
+    const QPolygon mapped = qwtToPointsMT<QPolygon, QPoint>( qwtInvalidRect,
+        xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+
+    Polygon polygon( mapped.size() );
+    Point *points = polygon.data();
+
+    QwtPixelMatrix pixelMatrix( boundingRect.toAlignedRect() );
+
+    int numPoints = 0;
+    for ( int i = 0; i < mapped.size(); i++ )
+    {
+        const int x = mapped[i].x();
+        const int y = mapped[i].y();
+
+        if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+        {
+            points[ numPoints ].rx() = x;
+            points[ numPoints ].ry() = y;
+
+            numPoints++;
+        }
+    }
+
+    polygon.resize( numPoints );
+    return polygon;
+}
+
+#endif
+
+// Mapping a series into a polyline. When runs is not NULL the 
+// clipped parts are appended to runs and the result is empty.
+
+static QPolygonF qwtToPolygonF( QwtPointMapper::TransformationFlags flags,
+    const QRectF &clipRect, uint renderThreadCount,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    QVector<QPolygonF> *runs )
+{
+    QPolygonF polyline;
+
+#if QWT_USE_THREADS
+    const uint numThreads = 
+        qwtThreadCount( renderThreadCount, to - from + 1 );
+
+    if ( numThreads > 1 )
+    {
+        if ( flags & QwtPointMapper::RoundPoints )
+        {
+            if ( flags & QwtPointMapper::WeedOutIntermediatePoints )
+            {
+                polyline = qwtMapPointsQuadMT<QPolygonF, QPointF>( 
+                    xMap, yMap, series, from, to, numThreads );
+            }
+            else if ( flags & QwtPointMapper::WeedOutPoints )
+            {
+                polyline = qwtToPolylineFilteredMT<QPolygonF, QPointF>( 
+                    xMap, yMap, series, from, to, QwtRoundF(), numThreads );
+            }
+            else
+            {
+                polyline = qwtToPointsMT<QPolygonF, QPointF>( qwtInvalidRect, 
+                    xMap, yMap, series, from, to, QwtRoundF(), numThreads );
+            }
+        }
+        else
+        {
+            if ( flags & QwtPointMapper::WeedOutPoints )
+            {
+                polyline = qwtToPolylineFilteredMT<QPolygonF, QPointF>( 
+                    xMap, yMap, series, from, to, QwtNoRoundF(), numThreads );
+            }
+            else
+            {
+                polyline = qwtToPointsMT<QPolygonF, QPointF>( qwtInvalidRect, 
+                    xMap, yMap, series, from, to, QwtNoRoundF(), numThreads );
+            }
+        }
+
+        if ( clipRect.isValid() )
+            polyline = qwtClipPolyline( clipRect, polyline, runs );
+
+        return polyline;
+    }
+#endif
+
+    const bool doWeedOut = flags & QwtPointMapper::WeedOutPoints;
+
+    if ( clipRect.isValid() && !( ( flags & QwtPointMapper::RoundPoints ) 
+        && ( flags & QwtPointMapper::WeedOutIntermediatePoints ) ) )
+    {
+        if ( flags & QwtPointMapper::RoundPoints )
+        {
+            polyline = qwtToPolylineClipped( clipRect,
+                xMap, yMap, series, from, to, doWeedOut, QwtRoundF(), runs );
+        }
+        else
+        {
+            polyline = qwtToPolylineClipped( clipRect,
+                xMap, yMap, series, from, to, doWeedOut, QwtNoRoundF(), runs );
+        }
+
+        return polyline;
+    }
+
+    if ( flags & QwtPointMapper::RoundPoints )
+    {
+        if ( flags & QwtPointMapper::WeedOutIntermediatePoints )
+        {
+            polyline = qwtMapPointsQuad<QPolygonF, QPointF>( 
+                xMap, yMap, series, from, to );
+        }
+        else if ( flags & QwtPointMapper::WeedOutPoints )
+        {
+            polyline = qwtToPolylineFilteredF( 
+                xMap, yMap, series, from, to, QwtRoundF() );
+        }
+        else
+        {
+            polyline = qwtToPointsF( qwtInvalidRect, 
+                xMap, yMap, series, from, to, QwtRoundF() );
+        }
+    }
+    else
+    {
+        if ( flags & QwtPointMapper::WeedOutPoints )
+        {
+            polyline = qwtToPolylineFilteredF( 
+                xMap, yMap, series, from, to, QwtNoRoundF() );
+        }
+        else
+        {
+            polyline = qwtToPointsF( qwtInvalidRect, 
+                xMap, yMap, series, from, to, QwtNoRoundF() );
+        }
+    }
+
+    if ( clipRect.isValid() )
+        polyline = qwtClipPolyline( clipRect, polyline, runs );
+
+    return polyline;
+}
+
 class QwtPointMapper::PrivateData
 {
 public:
     PrivateData():
-        boundingRect( qwtInvalidRect )
+        boundingRect( qwtInvalidRect ),
+        clipRect( qwtInvalidRect ),
+        renderThreadCount( 1 )
     {
     }
 
     QRectF boundingRect;
+    QRectF clipRect;
     QwtPointMapper::TransformationFlags flags;
+    uint renderThreadCount;
 };
 
 //! Constructor
@@ -617,6 +1649,64 @@ QRectF QwtPointMapper::boundingRect() const
     return d_data->boundingRect;
 }
 
+/*!
+  Set a rectangle for clipping polylines
+
+  When the clip rectangle is valid, toPolygonF() clips the polyline 
+  while mapping the points. Parts of the polyline outside of the
+  rectangle are replaced by lines on its border, like 
+  QwtClipper::clipPolygonF() does. 
+
+  \param rect Clip rectangle, an invalid rectangle disables clipping
+  \sa clipRect(), toPolygonF()
+ */
+void QwtPointMapper::setClipRect( const QRectF &rect )
+{
+    d_data->clipRect = rect;
+}
+
+/*!
+  \return Rectangle for clipping polylines
+  \sa setClipRect()
+ */
+QRectF QwtPointMapper::clipRect() const
+{
+    return d_data->clipRect;
+}
+
+/*!
+   On multi core systems the mapping of huge series can be done 
+   in parallel in several threads.
+
+   The index range is split into chunks, that are mapped in parallel.
+   The results are stitched together, so that they are identical
+   to the results of a single thread.
+
+   \param numThreads Number of threads to be used for mapping.
+                     If numThreads is set to 0, the system specific
+                     ideal thread count is used.
+
+   The default thread count is 1 ( = no additional threads )
+
+   \sa renderThreadCount(), QwtPlotItem::setRenderThreadCount()
+*/
+void QwtPointMapper::setRenderThreadCount( uint numThreads )
+{
+    d_data->renderThreadCount = numThreads;
+}
+
+/*!
+   \return Number of threads to be used for mapping.
+           If numThreads() is set to 0, the system specific
+           ideal thread count is used.
+
+   \sa setRenderThreadCount()
+*/
+uint QwtPointMapper::renderThreadCount() const
+{
+    return d_data->renderThreadCount;
+}
+
 /*!
   \brief Translate a series of points into a QPolygonF
 
@@ -630,6 +1720,12 @@ QRectF QwtPointMapper::boundingRect() const
   When RoundPoints & WeedOutIntermediatePoints is enabled an even more
   aggressive weeding algorithm is enabled.
 
+  When a valid clipRect() has been set, each line is clipped
+  while mapping the points. Then the mapped points are written
+  to the returned polygon only and runs of points outside of the
+  rectangle end up as their entry and exit points on the border
+  ( plus the corners in between ).
+
   \param xMap x map
   \param yMap y map
   \param series Series of points to be mapped
@@ -637,46 +1733,50 @@ QRectF QwtPointMapper::boundingRect() const
   \param to Index of the last point to be painted
 
   \return Translated polygon
+  \sa setClipRect()
 */
 QPolygonF QwtPointMapper::toPolygonF(
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
     const QwtSeriesData<QPointF> *series, int from, int to ) const
 {
-    QPolygonF polyline;
+    return qwtToPolygonF( d_data->flags, d_data->clipRect,
+        d_data->renderThreadCount, xMap, yMap, series, from, to, NULL );
+}
 
-    if ( d_data->flags & RoundPoints )
+/*!
+  \brief Translate a series of points into polylines
+
+  When a valid clipRect() has been set, the lines are clipped
+  like in toPolygonF(), but the parts of the polyline inside of 
+  the rectangle are returned as separate polylines instead of
+  connecting them by lines on the border.
+
+  \param xMap x map
+  \param yMap y map
+  \param series Series of points to be mapped
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+
+  \return Translated polylines
+  \sa toPolygonF(), setClipRect(), QwtClipper::clipPolylineF()
+*/
+QVector<QPolygonF> QwtPointMapper::toPolylinesF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to ) const
+{
+    QVector<QPolygonF> polylines;
+
+    if ( !d_data->clipRect.isValid() )
     {
-        if ( d_data->flags & WeedOutIntermediatePoints )
-        {
-            polyline = qwtMapPointsQuad<QPolygonF, QPointF>( 
-                xMap, yMap, series, from, to );
-        }
-        else if ( d_data->flags & WeedOutPoints )
-        {
-            polyline = qwtToPolylineFilteredF( 
-                xMap, yMap, series, from, to, QwtRoundF() );
-        }
-        else
-        {
-            polyline = qwtToPointsF( qwtInvalidRect, 
-                xMap, yMap, series, from, to, QwtRoundF() );
-        }
+        polylines += toPolygonF( xMap, yMap, series, from, to );
     }
     else
     {
-        if ( d_data->flags & WeedOutPoints )
-        {
-            polyline = qwtToPolylineFilteredF( 
-                xMap, yMap, series, from, to, QwtNoRoundF() );
-        }
-        else
-        {
-            polyline = qwtToPointsF( qwtInvalidRect, 
-                xMap, yMap, series, from, to, QwtNoRoundF() );
-        }
+        qwtToPolygonF( d_data->flags, d_data->clipRect, 
+            d_data->renderThreadCount, xMap, yMap, series, from, to, &polylines );
     }
 
-    return polyline;
+    return polylines;
 }
 
 /*!
@@ -699,6 +1799,32 @@ QPolygon QwtPointMapper::toPolygon(
 {
     QPolygon polyline;
 
+#if QWT_USE_THREADS
+    const uint numThreads = 
+        qwtThreadCount( d_data->renderThreadCount, to - from + 1 );
+
+    if ( numThreads > 1 )
+    {
+        if ( d_data->flags & WeedOutIntermediatePoints )
+        {
+            polyline = qwtMapPointsQuadMT<QPolygon, QPoint>( 
+                xMap, yMap, series, from, to, numThreads );
+        }
+        else if ( d_data->flags & WeedOutPoints )
+        {
+            polyline = qwtToPolylineFilteredMT<QPolygon, QPoint>( 
+                xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+        }
+        else
+        {
+            polyline = qwtToPointsMT<QPolygon, QPoint>( qwtInvalidRect,
+                xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+        }
+
+        return polyline;
+    }
+#endif
+
     if ( d_data->flags & WeedOutIntermediatePoints )
     {
         // TODO WeedOutIntermediatePointsY ...
@@ -756,6 +1882,53 @@ QPolygonF QwtPointMapper::toPointsF(
 {
     QPolygonF points;
 
+#if QWT_USE_THREADS
+    const uint numThreads = 
+        qwtThreadCount( d_data->renderThreadCount, to - from + 1 );
+
+    if ( numThreads > 1 )
+    {
+        const QRectF &rect = d_data->boundingRect;
+
+        if ( d_data->flags & WeedOutPoints )
+        {
+            if ( d_data->flags & RoundPoints )
+            {
+                if ( rect.isValid() )
+                {
+                    points = qwtToPointsFilteredMT<QPolygonF, QPointF>( rect,
+                        xMap, yMap, series, from, to, numThreads );
+                }
+                else
+                {
+                    points = qwtToPolylineFilteredMT<QPolygonF, QPointF>( 
+                        xMap, yMap, series, from, to, QwtRoundF(), numThreads );
+                }
+            }
+            else
+            {
+                points = qwtToPolylineFilteredMT<QPolygonF, QPointF>( 
+                    xMap, yMap, series, from, to, QwtNoRoundF(), numThreads );
+            }
+        }
+        else
+        {
+            if ( d_data->flags & RoundPoints )
+            {
+                points = qwtToPointsMT<QPolygonF, QPointF>( rect,
+                    xMap, yMap, series, from, to, QwtRoundF(), numThreads );
+            }
+            else
+            {
+                points = qwtToPointsMT<QPolygonF, QPointF>( rect,
+                    xMap, yMap, series, from, to, QwtNoRoundF(), numThreads );
+            }
+        }
+
+        return points;
+    }
+#endif
+
     if ( d_data->flags & WeedOutPoints )
     {
         if ( d_data->flags & RoundPoints )
@@ -830,6 +2003,37 @@ QPolygon QwtPointMapper::toPoints(
 {
     QPolygon points;
 
+#if QWT_USE_THREADS
+    const uint numThreads = 
+        qwtThreadCount( d_data->renderThreadCount, to - from + 1 );
+
+    if ( numThreads > 1 )
+    {
+        const QRectF &rect = d_data->boundingRect;
+
+        if ( d_data->flags & WeedOutPoints )
+        {
+            if ( rect.isValid() )
+            {
+                points = qwtToPointsFilteredMT<QPolygon, QPoint>( rect,
+                    xMap, yMap, series, from, to, numThreads );
+            }
+            else
+            {
+                points = qwtToPolylineFilteredMT<QPolygon, QPoint>( 
+                    xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+            }
+        }
+        else
+        {
+            points = qwtToPointsMT<QPolygon, QPoint>( rect,
+                xMap, yMap, series, from, to, QwtRoundI(), numThreads );
+        }
+
+        return points;
+    }
+#endif
+
     if ( d_data->flags & WeedOutPoints )
     {
         if ( d_data->boundingRect.isValid() )
@@ -855,6 +2059,95 @@ QPolygon QwtPointMapper::toPoints(
     return points;
 }
 
+/*!
+  \brief Translate a series into the corners of a step function
+
+  The corners are inserted between 2 samples, so that the
+  polyline starts horizontally and continues vertically. When
+  inverted is true it starts vertically and continues horizontally.
+
+  When RoundPoints and WeedOutPoints ( or WeedOutIntermediatePoints ) 
+  are enabled, each chunk of consecutive corners, that are mapped to
+  the same pixel column or row, is reduced to 4 points:
+  first, minimum, maximum and last point. As these chunks are 
+  vertical or horizontal lines the reduced polyline covers
+  exactly the same pixels - as long as the polyline is painted 
+  with an opaque pen and without antialiasing. For series with sorted x values its
+  size depends on the width of the canvas instead of the number of samples.
+
+  \param xMap x map
+  \param yMap y map
+  \param series Series of points to be mapped
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+  \param inverted Order of the horizontal and vertical line
+                  between 2 samples
+
+  \return Polyline of the step function
+  \sa QwtPlotCurve::Steps, QwtPlotCurve::Inverted
+*/
+QPolygonF QwtPointMapper::toSteps(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    bool inverted ) const
+{
+    if ( from > to )
+        return QPolygonF();
+
+    if ( d_data->flags & RoundPoints )
+    {
+        if ( d_data->flags & ( WeedOutPoints | WeedOutIntermediatePoints ) )
+            return qwtMapStepsQuad( xMap, yMap, series, from, to, inverted );
+
+        return qwtMapSteps( xMap, yMap, series, from, to, inverted, QwtRoundF() );
+    }
+
+    return qwtMapSteps( xMap, yMap, series, from, to, inverted, QwtNoRoundF() );
+}
+
+/*!
+  \brief Translate a series into the end points of sticks
+
+  When RoundPoints and WeedOutPoints ( or WeedOutIntermediatePoints ) 
+  are enabled, each chunk of consecutive points, that are mapped to the 
+  same pixel column ( row for horizontal sticks ), is reduced to 
+  the points with the minimum and maximum coordinate. As the sticks 
+  start at the same baseline the reduced sticks cover exactly 
+  the same pixels. However the result is not identical, when 
+  painting the sticks with a translucent pen, where overlapping
+  sticks blend.
+
+  \param xMap x map
+  \param yMap y map
+  \param series Series of points to be mapped
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+  \param orientation Qt::Vertical for sticks from a horizontal baseline,
+                     Qt::Horizontal for sticks from a vertical baseline
+
+  \return End points of the sticks
+  \sa QwtPlotCurve::Sticks
+*/
+QPolygonF QwtPointMapper::toSticks(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    Qt::Orientation orientation ) const
+{
+    if ( from > to )
+        return QPolygonF();
+
+    if ( d_data->flags & RoundPoints )
+    {
+        if ( d_data->flags & ( WeedOutPoints | WeedOutIntermediatePoints ) )
+            return qwtMapSticksReduced( xMap, yMap, series, from, to, orientation );
+
+        return qwtToPointsF( qwtInvalidRect, 
+            xMap, yMap, series, from, to, QwtRoundF() );
+    }
+
+    return qwtToPointsF( qwtInvalidRect, 
+        xMap, yMap, series, from, to, QwtNoRoundF() );
+}
 
 /*!
   \brief Translate a series into a QImage
@@ -865,7 +2158,9 @@ QPolygon QwtPointMapper::toPoints(
   \param from Index of the first point to be painted
   \param to Index of the last point to be painted
   \param pen Pen used for drawing a point
-             of the image, where a point is mapped to
+             of the image, where a point is mapped to.
+             The dots are squares of the width of the pen,
+             or circles for pens with a Qt::RoundCap.
   \param antialiased True, when the dots should be displayed
                      antialiased
   \param numThreads Number of threads to be used for rendering.
@@ -879,31 +2174,46 @@ QImage QwtPointMapper::toImage(
     const QwtSeriesData<QPointF> *series, int from, int to, 
     const QPen &pen, bool antialiased, uint numThreads ) const
 {
-    Q_UNUSED( antialiased )
-
 #if QWT_USE_THREADS
-    if ( numThreads == 0 )
-        numThreads = QThread::idealThreadCount();
-
-    if ( numThreads <= 0 )
-        numThreads = 1;
+    numThreads = qwtThreadCount( numThreads, to - from + 1 );
 #else
     Q_UNUSED( numThreads )
 #endif
 
-    // a very special optimization for scatter plots
-    // where every sample is mapped to one pixel only.
-
     const QRect rect = d_data->boundingRect.toAlignedRect();
+    const QPoint pos = rect.topLeft();
 
     QImage image( rect.size(), QImage::Format_ARGB32 );
     image.fill( Qt::transparent );
 
-    if ( pen.width() <= 1 && pen.color().alpha() == 255 )
+    const double penWidth = qMax( pen.widthF(), 1.0 );
+    const bool isOpaque = pen.color().alpha() == 255;
+
+    QwtDotsCommand command;
+    command.series = series;
+    command.rgb = pen.color().rgba();
+    command.radius = 0.5 * penWidth;
+    command.round = pen.capStyle() == Qt::RoundCap;
+    command.antialiased = antialiased;
+    command.opacity = pen.color().alphaF();
+    command.rowFrom = 0;
+    command.rowTo = image.height() - 1;
+
+    if ( isOpaque && ( penWidth <= 1.0 || !antialiased ) )
     {
-        QwtDotsCommand command;
-        command.series = series;
-        command.rgb = pen.color().rgba();
+        // all pixels are either covered or not, so we can
+        // set them directly - even from different threads
+
+        void ( *renderFunc )( const QwtScaleMap &, const QwtScaleMap &,
+            const QwtDotsCommand, const QPoint &, QImage * ) = qwtRenderPenDots;
+
+        if ( penWidth <= 1.0 )
+        {
+            // a very special optimization for scatter plots
+            // where every sample is mapped to one pixel only.
+
+            renderFunc = qwtRenderDots;
+        }
 
 #if QWT_USE_THREADS
         const int numPoints = ( to - from + 1 ) / numThreads;
@@ -911,22 +2221,20 @@ QImage QwtPointMapper::toImage(
         QList< QFuture<void> > futures;
         for ( uint i = 0; i < numThreads; i++ )
         {
-            const QPoint pos = rect.topLeft();
-
             const int index0 = from + i * numPoints;
             if ( i == numThreads - 1 )
             {
                 command.from = index0;
                 command.to = to;
 
-                qwtRenderDots( xMap, yMap, command, pos, &image );
+                renderFunc( xMap, yMap, command, pos, &image );
             }
             else
             {
                 command.from = index0;
                 command.to = index0 + numPoints - 1;
 
-                futures += QtConcurrent::run( &qwtRenderDots, 
+                futures += QtConcurrent::run( renderFunc, 
                     xMap, yMap, command, pos, &image );
             }
         }
@@ -936,27 +2244,73 @@ QImage QwtPointMapper::toImage(
         command.from = from;
         command.to = to;
 
-        qwtRenderDots( xMap, yMap, command, rect.topLeft(), &image );
+        renderFunc( xMap, yMap, command, pos, &image );
 #endif
     }
     else
     {
-        // fallback implementation: to be replaced later by
-        // setting the pixels of the image like above, TODO ...
+        /*
+          Semi transparent or antialiased dots need to be blended.
+          The transmittance of the dots is accumulated in a buffer,
+          where each thread is responsible for a band of rows.
+          As every thread iterates over all points, the 
+          transmittances of a pixel are multiplied in the same order 
+          as without threads.
+         */
+
+        const int w = image.width();
+        const int h = image.height();
+
+        QwtTransmittanceBuffer *buffer = new QwtTransmittanceBuffer( w, h );
+
+        command.from = from;
+        command.to = to;
+
+#if QWT_USE_THREADS
+        // each thread needs a band of at least a couple of rows
+        numThreads = qMin( numThreads, uint( qMax( h / 16, 1 ) ) );
 
-        QPainter painter( &image );
-        painter.setPen( pen );
-        painter.setRenderHint( QPainter::Antialiasing, antialiased );
+        const int numRows = h / numThreads;
 
-        const int chunkSize = 1000;
-        for ( int i = from; i <= to; i += chunkSize )
+        QList< QFuture<void> > futures;
+        for ( uint i = 0; i < numThreads; i++ )
         {
-            const int indexTo = qMin( i + chunkSize - 1, to );
-            const QPolygon points = toPoints(
-                xMap, yMap, series, i, indexTo );
+            command.rowFrom = i * numRows;
+
+            if ( i == numThreads - 1 )
+            {
+                command.rowTo = h - 1;
+
+                qwtRenderPenDotsAttenuated( xMap, yMap, 
+                    command, pos, buffer );
+            }
+            else
+            {
+                command.rowTo = command.rowFrom + numRows - 1;
+
+                futures += QtConcurrent::run( &qwtRenderPenDotsAttenuated, 
+                    xMap, yMap, command, pos, buffer );
+            }
+        }
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#else
+        qwtRenderPenDotsAttenuated( xMap, yMap, command, pos, buffer );
+#endif
 
-            painter.drawPoints( points );
+        const QRgb rgb = command.rgb;
+
+        QRgb *bits = reinterpret_cast<QRgb *>( image.bits() );
+        const float *values = buffer->values.constData();
+
+        for ( int i = 0; i < w * h; i++ )
+        {
+            const int alpha = qRound( 255.0 * ( 1.0 - values[i] ) );
+            if ( alpha > 0 )
+                bits[i] = qRgba( qRed( rgb ), qGreen( rgb ), qBlue( rgb ), alpha );
         }
+
+        delete buffer;
     }
 
     return image;
@@ -83,9 +83,19 @@ public:
     void setBoundingRect( const QRectF & );
     QRectF boundingRect() const;
 
+    void setClipRect( const QRectF & );
+    QRectF clipRect() const;
+
+    void setRenderThreadCount( uint numThreads );
+    uint renderThreadCount() const;
+
     QPolygonF toPolygonF( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
+    QVector<QPolygonF> toPolylinesF( 
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QwtSeriesData<QPointF> *series, int from, int to ) const;
+
     QPolygon toPolygon( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
@@ -95,6 +105,14 @@ public:
     QPolygonF toPointsF( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
+    QPolygonF toSteps( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QwtSeriesData<QPointF> *series, int from, int to, 
+        bool inverted ) const;
+
+    QPolygonF toSticks( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QwtSeriesData<QPointF> *series, int from, int to, 
+        Qt::Orientation ) const;
+
     QImage toImage( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to, 
         const QPen &, bool antialiased, uint numThreads ) const;
@@ -0,0 +1,67 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_point_pyramid_data.h"
+
+/*!
+  Constructor
+  \param samples Samples
+ */
+QwtPointPyramidData::QwtPointPyramidData( const QVector<QPointF> &samples ):
+    QwtPointSeriesData( samples )
+{
+}
+
+//! Destructor
+QwtPointPyramidData::~QwtPointPyramidData()
+{
+}
+
+/*!
+  Assign an array of samples and invalidate the pyramid
+  \param samples Array of samples
+*/
+void QwtPointPyramidData::setSamples( const QVector<QPointF> &samples )
+{
+    d_pyramid.reset();
+    QwtPointSeriesData::setSamples( samples );
+}
+
+/*!
+  \brief Reduce a range of samples to the first, last, minimum and
+         maximum samples of each pixel column
+
+  \param xMap Maps x-values into pixel coordinates
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param indices Indices of the samples, that have to be painted
+
+  \return true, when indices has been filled
+  \sa QwtMinMaxPyramid::levelOfDetail()
+ */
+bool QwtPointPyramidData::levelOfDetail( const QwtScaleMap &xMap,
+    int from, int to, QVector<int> &indices ) const
+{
+    if ( d_pyramid.size() != size() )
+        d_pyramid.build( *this );
+
+    return d_pyramid.levelOfDetail( *this, xMap, from, to, indices );
+}
+
+/*!
+  \return Min/max pyramid of the samples
+  \note The pyramid is built, when it is needed the first time
+ */
+const QwtMinMaxPyramid &QwtPointPyramidData::pyramid() const
+{
+    if ( d_pyramid.size() != size() )
+        d_pyramid.build( *this );
+
+    return d_pyramid;
+}
@@ -0,0 +1,53 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_POINT_PYRAMID_DATA_H
+#define QWT_POINT_PYRAMID_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_minmax_pyramid.h"
+
+/*!
+  \brief Point series with a min/max pyramid for huge data sets
+
+  QwtPointPyramidData is a QwtPointSeriesData, that implements
+  levelOfDetail() using a QwtMinMaxPyramid. The pyramid is built
+  on demand, when the series is painted the first time.
+
+  When being displayed by a QwtPlotCurve with the QwtPlotCurve::Lines style
+  only the first, last, minimum and maximum samples of each pixel column
+  of the visible range are painted. So the costs for a replot depend on
+  the width of the canvas instead of the number of samples, while the curve
+  looks the same.
+
+  The x coordinates of the samples have to be monotonic.
+
+  \sa QwtMinMaxPyramid, QwtSeriesData::levelOfDetail()
+ */
+class QWT_EXPORT QwtPointPyramidData: public QwtPointSeriesData
+{
+public:
+    QwtPointPyramidData(
+        const QVector<QPointF> & = QVector<QPointF>() );
+
+    virtual ~QwtPointPyramidData();
+
+    void setSamples( const QVector<QPointF> & );
+
+    virtual bool levelOfDetail( const QwtScaleMap &xMap,
+        int from, int to, QVector<int> &indices ) const;
+
+    const QwtMinMaxPyramid &pyramid() const;
+
+private:
+    mutable QwtMinMaxPyramid d_pyramid;
+};
+
+#endif
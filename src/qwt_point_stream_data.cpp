@@ -0,0 +1,422 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_point_stream_data.h"
+#include <qalgorithms.h>
+#include <string.h>
+
+class QwtChunkSummary
+{
+public:
+    QwtChunkSummary()
+    {
+    }
+
+    QwtChunkSummary( const QPointF &pos ):
+        minX( pos.x() ),
+        maxX( pos.x() ),
+        minY( pos.y() ),
+        maxY( pos.y() )
+    {
+    }
+
+    inline void extend( const QPointF &pos )
+    {
+        minX = qMin( minX, pos.x() );
+        maxX = qMax( maxX, pos.x() );
+        minY = qMin( minY, pos.y() );
+        maxY = qMax( maxY, pos.y() );
+    }
+
+    inline void extend( const QwtChunkSummary &other )
+    {
+        minX = qMin( minX, other.minX );
+        maxX = qMax( maxX, other.maxX );
+        minY = qMin( minY, other.minY );
+        maxY = qMax( maxY, other.maxY );
+    }
+
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+
+class QwtStreamBlock
+{
+public:
+    // Chunk i summarizes samples[i * ChunkSize] to 
+    // samples[(i + 1) * ChunkSize - 1]
+
+    inline void append( const QPointF &sample )
+    {
+        if ( samples.isEmpty() )
+            summary = QwtChunkSummary( sample );
+        else
+            summary.extend( sample );
+
+        if ( ( samples.size() % QwtPointStreamData::ChunkSize ) == 0 )
+            chunks += QwtChunkSummary( sample );
+        else
+            chunks.last().extend( sample );
+
+        samples += sample;
+    }
+
+    QVector<QPointF> samples;
+    QVector<QwtChunkSummary> chunks;
+    QwtChunkSummary summary;
+};
+
+class QwtPointStreamData::PrivateData
+{
+public:
+    PrivateData():
+        offset( 0 ),
+        numSamples( 0 ),
+        maxSize( 0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        qDeleteAll( blocks );
+    }
+
+    inline const QPointF &sample( int index ) const
+    {
+        const int pos = offset + index;
+        return blocks[ pos / BlockSize ]->samples[ pos % BlockSize ];
+    }
+
+    QwtChunkSummary summary( int from, int to ) const;
+
+    /*
+      The first offset samples of the first block have been removed.
+      All blocks beside the last one are full.
+     */
+    QVector<QwtStreamBlock *> blocks;
+    int offset;
+    int numSamples;
+
+    size_t maxSize;
+};
+
+QwtChunkSummary QwtPointStreamData::PrivateData::summary( 
+    int from, int to ) const
+{
+    // from/to are positions including the removed samples
+
+    QwtChunkSummary s( blocks[ from / BlockSize ]->samples[ from % BlockSize ] );
+
+    int pos = from + 1;
+    while ( pos <= to )
+    {
+        const QwtStreamBlock *block = blocks[ pos / BlockSize ];
+        const int i = pos % BlockSize;
+
+        if ( i == 0 && pos + BlockSize - 1 <= to )
+        {
+            s.extend( block->summary );
+            pos += BlockSize;
+        }
+        else if ( ( i % ChunkSize ) == 0 && pos + ChunkSize - 1 <= to )
+        {
+            s.extend( block->chunks[ i / ChunkSize ] );
+            pos += ChunkSize;
+        }
+        else
+        {
+            s.extend( block->samples[i] );
+            pos++;
+        }
+    }
+
+    return s;
+}
+
+//! Constructor
+QwtPointStreamData::QwtPointStreamData()
+{
+    d_data = new PrivateData();
+}
+
+/*!
+  Constructor
+
+  \param samples Initial samples
+ */
+QwtPointStreamData::QwtPointStreamData( const QVector<QPointF> &samples )
+{
+    d_data = new PrivateData();
+    append( samples.constData(), samples.size() );
+}
+
+//! Destructor
+QwtPointStreamData::~QwtPointStreamData()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Limit the number of samples
+
+  When the number of samples exceeds maxSize, the oldest
+  samples are removed, what makes a sliding window.
+
+  \param maxSize Maximum number of samples, 0 means unlimited
+  \sa maxSize(), removeFirst()
+ */
+void QwtPointStreamData::setMaxSize( size_t maxSize )
+{
+    d_data->maxSize = maxSize;
+
+    if ( maxSize > 0 && size() > maxSize )
+        removeFirst( size() - maxSize );
+}
+
+/*!
+  \return Maximum number of samples, 0 means unlimited
+  \sa setMaxSize()
+ */
+size_t QwtPointStreamData::maxSize() const
+{
+    return d_data->maxSize;
+}
+
+/*!
+  \brief Append a sample
+  \param sample New sample
+ */
+void QwtPointStreamData::append( const QPointF &sample )
+{
+    append( &sample, 1 );
+}
+
+/*!
+  \brief Append samples
+
+  \param samples Array of samples
+  \param count Number of samples
+ */
+void QwtPointStreamData::append( const QPointF *samples, size_t count )
+{
+    if ( count == 0 )
+        return;
+
+    PrivateData *d = d_data;
+
+    const bool isValid = d_boundingRect.width() >= 0.0;
+    QwtChunkSummary s;
+    if ( isValid )
+    {
+        s.minX = d_boundingRect.left();
+        s.maxX = d_boundingRect.right();
+        s.minY = d_boundingRect.top();
+        s.maxY = d_boundingRect.bottom();
+    }
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const QPointF &sample = samples[i];
+
+        if ( d->blocks.isEmpty() 
+            || d->blocks.last()->samples.size() == BlockSize )
+        {
+            d->blocks += new QwtStreamBlock();
+        }
+
+        d->blocks.last()->append( sample );
+
+        if ( isValid )
+            s.extend( sample );
+    }
+
+    d->numSamples += static_cast<int>( count );
+
+    if ( isValid )
+        d_boundingRect.setCoords( s.minX, s.minY, s.maxX, s.maxY );
+
+    const size_t maxSize = d_data->maxSize;
+    if ( maxSize > 0 && size() > maxSize )
+        removeFirst( size() - maxSize );
+}
+
+/*!
+  \brief Remove the oldest samples
+
+  The costs for removing samples are proportional to their number.
+  When one of them has been on the border of the bounding rectangle, 
+  the rectangle is recalculated from the chunk summaries.
+
+  \param count Number of samples to be removed
+  \sa setMaxSize(), clear()
+ */
+void QwtPointStreamData::removeFirst( size_t count )
+{
+    const int n = static_cast<int>( qMin( count, size() ) );
+    if ( n <= 0 )
+        return;
+
+    if ( n == d_data->numSamples )
+    {
+        clear();
+        return;
+    }
+
+    PrivateData *d = d_data;
+
+    if ( d_boundingRect.width() >= 0.0 )
+    {
+        const QRectF &r = d_boundingRect;
+
+        for ( int i = 0; i < n; i++ )
+        {
+            const QPointF &pos = d->sample( i );
+
+            if ( pos.x() <= r.left() || pos.x() >= r.right()
+                || pos.y() <= r.top() || pos.y() >= r.bottom() )
+            {
+                d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+                break;
+            }
+        }
+    }
+
+    d->offset += n;
+    d->numSamples -= n;
+
+    // releasing the blocks, that have been removed completely
+
+    const int numBlocks = d->offset / BlockSize;
+    if ( numBlocks > 0 )
+    {
+        for ( int i = 0; i < numBlocks; i++ )
+            delete d->blocks[i];
+
+        d->blocks.remove( 0, numBlocks );
+        d->offset -= numBlocks * BlockSize;
+    }
+}
+
+//! Remove all samples
+void QwtPointStreamData::clear()
+{
+    qDeleteAll( d_data->blocks );
+    d_data->blocks.clear();
+
+    d_data->offset = 0;
+    d_data->numSamples = 0;
+
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+//! \return Number of samples
+size_t QwtPointStreamData::size() const
+{
+    return d_data->numSamples;
+}
+
+/*!
+  \return Sample at a specific position
+
+  \param index Index
+ */
+QPointF QwtPointStreamData::sample( size_t index ) const
+{
+    return d_data->sample( static_cast<int>( index ) );
+}
+
+/*!
+  \brief Copy a range of samples
+
+  \param from Index of the first sample
+  \param count Number of samples
+  \param samples Array, where the samples are copied to
+ */
+void QwtPointStreamData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    const PrivateData *d = d_data;
+
+    int pos = d->offset + static_cast<int>( from );
+    int n = static_cast<int>( count );
+
+    while ( n > 0 )
+    {
+        const int i = pos % BlockSize;
+        const int numSamples = qMin( n, BlockSize - i );
+
+        ::memcpy( samples, d->blocks[ pos / BlockSize ]->samples.constData() + i,
+            numSamples * sizeof( QPointF ) );
+
+        samples += numSamples;
+        pos += numSamples;
+        n -= numSamples;
+    }
+}
+
+/*!
+  \brief Calculate the bounding rectangle
+
+  The rectangle is extended, when appending samples. It is only
+  recalculated - from the chunk summaries - when samples on its
+  border have been removed.
+
+  \return Bounding rectangle
+*/
+QRectF QwtPointStreamData::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0.0 )
+    {
+        const PrivateData *d = d_data;
+
+        if ( d->numSamples <= 0 )
+            return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+        const QwtChunkSummary s = 
+            d->summary( d->offset, d->offset + d->numSamples - 1 );
+        d_boundingRect.setCoords( s.minX, s.minY, s.maxX, s.maxY );
+    }
+
+    return d_boundingRect;
+}
+
+/*!
+  \brief Calculate the bounding rectangle of a range of samples
+
+  The rectangle is calculated from the summaries of all blocks and
+  chunks, that are completely inside of the range. Only the samples 
+  at the borders of the range need to be iterated.
+
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param rect Bounding rectangle of the samples
+
+  \return true
+*/
+bool QwtPointStreamData::rangeBoundingRect( 
+    int from, int to, QRectF &rect ) const
+{
+    const PrivateData *d = d_data;
+
+    from = qMax( from, 0 );
+    to = qMin( to, d->numSamples - 1 );
+
+    if ( from > to )
+    {
+        rect = QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+        return true;
+    }
+
+    const QwtChunkSummary s = d->summary( d->offset + from, d->offset + to );
+    rect.setCoords( s.minX, s.minY, s.maxX, s.maxY );
+
+    return true;
+}
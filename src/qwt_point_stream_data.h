@@ -0,0 +1,77 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_POINT_STREAM_DATA_H
+#define QWT_POINT_STREAM_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+/*!
+  \brief Series of points, that grows by appending samples
+
+  QwtPointStreamData is an array of points, that is optimized for
+  appending samples at the end and removing samples from the beginning 
+  ( sliding windows ).
+
+  The samples are stored in blocks of BlockSize samples. Appending
+  samples never moves more than one block in memory and removing
+  samples from the beginning releases the memory of all blocks, that
+  have been removed completely.
+
+  The bounding rectangle is extended for each appended sample. Additionally
+  the minimum and maximum coordinates of each block and of each chunk 
+  of ChunkSize samples are stored. They are used to recalculate the 
+  bounding rectangle, when samples have been removed, and to calculate
+  the bounding rectangle of a range of samples ( f.e. the visible 
+  range of a curve ) without iterating over all of them.
+
+  \sa QwtPlotCurve::appendSamples()
+*/
+class QWT_EXPORT QwtPointStreamData: public QwtSeriesData<QPointF>
+{
+public:
+    enum
+    {
+        //! Number of samples, that are summarized by a chunk
+        ChunkSize = 256,
+
+        //! Number of samples, that are stored in one memory block
+        BlockSize = 65536
+    };
+
+    QwtPointStreamData();
+    explicit QwtPointStreamData( const QVector<QPointF> & );
+    virtual ~QwtPointStreamData();
+
+    void setMaxSize( size_t );
+    size_t maxSize() const;
+
+    void append( const QPointF & );
+    void append( const QPointF *samples, size_t count );
+
+    void removeFirst( size_t count );
+    void clear();
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
+
+private:
+    Q_DISABLE_COPY(QwtPointStreamData)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -0,0 +1,430 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_ring_buffer_data.h"
+#include <qatomic.h>
+#include <string.h>
+
+static inline int qwtLoadAcquire( const QAtomicInt &value )
+{
+#if QT_VERSION >= 0x050000
+    return value.loadAcquire();
+#else
+    return const_cast<QAtomicInt &>( value ).fetchAndAddAcquire( 0 );
+#endif
+}
+
+static inline void qwtStoreRelease( QAtomicInt &value, int newValue )
+{
+#if QT_VERSION >= 0x050000
+    value.storeRelease( newValue );
+#else
+    value.fetchAndStoreRelease( newValue );
+#endif
+}
+
+class QwtRingChunk
+{
+public:
+    QwtRingChunk():
+        minX( 0.0 ),
+        maxX( 0.0 ),
+        minY( 0.0 ),
+        maxY( 0.0 )
+    {
+    }
+
+    QwtRingChunk( const QPointF &pos ):
+        minX( pos.x() ),
+        maxX( pos.x() ),
+        minY( pos.y() ),
+        maxY( pos.y() )
+    {
+    }
+
+    inline void extend( const QPointF &pos )
+    {
+        minX = qMin( minX, pos.x() );
+        maxX = qMax( maxX, pos.x() );
+        minY = qMin( minY, pos.y() );
+        maxY = qMax( maxY, pos.y() );
+    }
+
+    inline void extend( const QwtRingChunk &other )
+    {
+        minX = qMin( minX, other.minX );
+        maxX = qMax( maxX, other.maxX );
+        minY = qMin( minY, other.minY );
+        maxY = qMax( maxY, other.maxY );
+    }
+
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+};
+
+class QwtRingBufferData::PrivateData
+{
+public:
+    enum
+    {
+        // Number of buffer positions, that are summarized by a chunk
+        ChunkSize = 256
+    };
+
+    PrivateData( int size ):
+        capacity( size ),
+        samples( new QPointF[ size ] ),
+        chunks( ( size + ChunkSize - 1 ) / ChunkSize ),
+        writePos( 0 ),
+        readPos( 0 ),
+        head( 0 ),
+        count( 0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete[] samples;
+    }
+
+    /*
+      Positions are counted modulo 2 * capacity, so that a full 
+      buffer can be distinguished from an empty one.
+     */
+    inline int distance( int pos1, int pos2 ) const
+    {
+        int d = pos2 - pos1;
+        if ( d < 0 )
+            d += 2 * capacity;
+
+        return d;
+    }
+
+    inline int advance( int pos, int n ) const
+    {
+        pos += n;
+        if ( pos >= 2 * capacity )
+            pos -= 2 * capacity;
+
+        return pos;
+    }
+
+    inline int bufferIndex( int pos ) const
+    {
+        return ( pos >= capacity ) ? pos - capacity : pos;
+    }
+
+    QRectF boundingRect() const;
+
+    const int capacity;
+    QPointF *samples;
+
+    /*
+      Chunk i summarizes the samples at the buffer positions 
+      from i * ChunkSize to the last one, that has been 
+      included by update(). As the buffer is filled sequentially,
+      the summary of a chunk, that is completely inside of 
+      the snapshot, is valid.
+     */
+    QVector<QwtRingChunk> chunks;
+
+    // written by the producer
+    QAtomicInt writePos;
+
+    // written by the consumer
+    QAtomicInt readPos;
+
+    // the snapshot of the consumer
+    int head;
+    int count;
+};
+
+QRectF QwtRingBufferData::PrivateData::boundingRect() const
+{
+    int index = bufferIndex( head );
+
+    QwtRingChunk r( samples[index] );
+
+    int n = 1;
+    if ( ++index == capacity )
+        index = 0;
+
+    while ( n < count )
+    {
+        const int chunkLength = qMin( int( ChunkSize ), capacity - index );
+
+        if ( ( index % ChunkSize ) == 0 && n + chunkLength <= count )
+        {
+            r.extend( chunks[ index / ChunkSize ] );
+
+            n += chunkLength;
+            index += chunkLength;
+        }
+        else
+        {
+            r.extend( samples[index] );
+
+            n++;
+            index++;
+        }
+
+        if ( index == capacity )
+            index = 0;
+    }
+
+    return QRectF( r.minX, r.minY, r.maxX - r.minX, r.maxY - r.minY );
+}
+
+/*!
+  \brief Constructor
+
+  \param capacity Maximum number of samples in the buffer
+ */
+QwtRingBufferData::QwtRingBufferData( size_t capacity )
+{
+    const size_t maxCapacity = 0x3fffffff;
+    d_data = new PrivateData( 
+        static_cast<int>( qBound( size_t( 1 ), capacity, maxCapacity ) ) );
+}
+
+//! Destructor
+QwtRingBufferData::~QwtRingBufferData()
+{
+    delete d_data;
+}
+
+//! \return Maximum number of samples in the buffer
+size_t QwtRingBufferData::capacity() const
+{
+    return d_data->capacity;
+}
+
+/*!
+  \brief Append a sample
+
+  append() is intended to be called from the producer thread.
+
+  \param sample New sample
+  \return false, when the buffer is full
+ */
+bool QwtRingBufferData::append( const QPointF &sample )
+{
+    return append( &sample, 1 ) == 1;
+}
+
+/*!
+  \brief Append samples
+
+  append() is intended to be called from the producer thread.
+  When the buffer has not enough space for all samples, the 
+  leading samples are appended only.
+
+  \param samples Array of new samples
+  \param count Number of samples
+  \return Number of samples, that have been appended
+ */
+size_t QwtRingBufferData::append( const QPointF *samples, size_t count )
+{
+    const int writePos = qwtLoadAcquire( d_data->writePos );
+    const int readPos = qwtLoadAcquire( d_data->readPos );
+
+    const int numFree = d_data->capacity - d_data->distance( readPos, writePos );
+    const int n = static_cast<int>( qMin( count, size_t( numFree ) ) );
+
+    if ( n <= 0 )
+        return 0;
+
+    const int index = d_data->bufferIndex( writePos );
+    const int n1 = qMin( n, d_data->capacity - index );
+
+    ::memcpy( d_data->samples + index, samples, n1 * sizeof( QPointF ) );
+    if ( n1 < n )
+        ::memcpy( d_data->samples, samples + n1, ( n - n1 ) * sizeof( QPointF ) );
+
+    qwtStoreRelease( d_data->writePos, d_data->advance( writePos, n ) );
+
+    return n;
+}
+
+/*!
+  \brief Include the samples, that have been appended since the last update
+
+  The bounding rectangle is extended by the new samples.
+
+  \return Number of new samples
+  \sa discard()
+ */
+size_t QwtRingBufferData::update()
+{
+    const int writePos = qwtLoadAcquire( d_data->writePos );
+
+    const int count = d_data->distance( d_data->head, writePos );
+    const int numNew = count - d_data->count;
+
+    if ( numNew <= 0 )
+        return 0;
+
+    const int from = d_data->count;
+    d_data->count = count;
+
+    const bool extendRect = d_boundingRect.width() >= 0.0;
+
+    double minX = d_boundingRect.left();
+    double maxX = d_boundingRect.right();
+    double minY = d_boundingRect.top();
+    double maxY = d_boundingRect.bottom();
+
+    int index = d_data->bufferIndex( d_data->advance( d_data->head, from ) );
+
+    QwtSeriesReader<QPointF> reader( *this, from, count - 1 );
+    while ( reader.hasNext() )
+    {
+        const QPointF &sample = reader.next();
+
+        QwtRingChunk &chunk = d_data->chunks[ index / PrivateData::ChunkSize ];
+        if ( ( index % PrivateData::ChunkSize ) == 0 )
+            chunk = QwtRingChunk( sample );
+        else
+            chunk.extend( sample );
+
+        if ( ++index == d_data->capacity )
+            index = 0;
+
+        if ( extendRect )
+        {
+            minX = qMin( minX, sample.x() );
+            maxX = qMax( maxX, sample.x() );
+            minY = qMin( minY, sample.y() );
+            maxY = qMax( maxY, sample.y() );
+        }
+    }
+
+    if ( extendRect )
+        d_boundingRect.setCoords( minX, minY, maxX, maxY );
+
+    return numNew;
+}
+
+/*!
+  \brief Release the oldest samples of the snapshot
+
+  The producer can reuse the space of the discarded samples.
+  When samples on the border of the bounding rectangle are 
+  discarded it has to be recalculated, what is done from 
+  summaries of chunks of samples.
+
+  \param count Number of samples to be discarded
+  \sa update(), clear()
+ */
+void QwtRingBufferData::discard( size_t count )
+{
+    const int n = static_cast<int>( qMin( count, size_t( d_data->count ) ) );
+    if ( n <= 0 )
+        return;
+
+    if ( d_boundingRect.width() >= 0.0 )
+    {
+        const QRectF &r = d_boundingRect;
+
+        QwtSeriesReader<QPointF> reader( *this, 0, n - 1 );
+        while ( reader.hasNext() )
+        {
+            const QPointF &sample = reader.next();
+
+            if ( sample.x() <= r.left() || sample.x() >= r.right()
+                || sample.y() <= r.top() || sample.y() >= r.bottom() )
+            {
+                d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+                break;
+            }
+        }
+    }
+
+    d_data->head = d_data->advance( d_data->head, n );
+    d_data->count -= n;
+
+    qwtStoreRelease( d_data->readPos, d_data->head );
+
+    if ( d_data->count == 0 )
+        d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+  \brief Discard all samples of the snapshot
+  \sa discard(), update()
+ */
+void QwtRingBufferData::clear()
+{
+    discard( d_data->count );
+}
+
+/*!
+  \return Number of samples of the snapshot
+  \sa update()
+ */
+size_t QwtRingBufferData::size() const
+{
+    return d_data->count;
+}
+
+/*!
+  \return Sample at a specific position of the snapshot
+
+  \param index Index
+ */
+QPointF QwtRingBufferData::sample( size_t index ) const
+{
+    const int pos = d_data->advance( d_data->head, static_cast<int>( index ) );
+    return d_data->samples[ d_data->bufferIndex( pos ) ];
+}
+
+/*!
+  \brief Copy a range of samples of the snapshot
+
+  \param from Index of the first sample
+  \param count Number of samples
+  \param samples Array, where the samples are copied to
+ */
+void QwtRingBufferData::copySamples( size_t from,
+    size_t count, QPointF *samples ) const
+{
+    const int pos = d_data->advance( d_data->head, static_cast<int>( from ) );
+    const int index = d_data->bufferIndex( pos );
+
+    const size_t n1 = qMin( count, size_t( d_data->capacity - index ) );
+
+    ::memcpy( samples, d_data->samples + index, n1 * sizeof( QPointF ) );
+    if ( n1 < count )
+        ::memcpy( samples + n1, d_data->samples, ( count - n1 ) * sizeof( QPointF ) );
+}
+
+/*!
+  \brief Calculate the bounding rectangle
+
+  The rectangle is extended in update(). When samples on its border 
+  have been discarded it is recalculated from the min/max summaries
+  of chunks of samples, so that only the samples at the beginning 
+  and the end of the snapshot have to be read.
+
+  \return Bounding rectangle
+*/
+QRectF QwtRingBufferData::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0.0 )
+    {
+        if ( d_data->count > 0 )
+            d_boundingRect = d_data->boundingRect();
+        else
+            d_boundingRect = qwtBoundingRect( *this );
+    }
+
+    return d_boundingRect;
+}
@@ -0,0 +1,84 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RING_BUFFER_DATA_H
+#define QWT_RING_BUFFER_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+/*!
+  \brief Series of points, that are appended by another thread
+
+  QwtRingBufferData is a fixed size ring buffer for one producer thread,
+  that appends samples, and one consumer - the GUI thread displaying
+  them. No locks are involved: producer and consumer synchronize
+  by 2 atomic counters only.
+
+  The consumer sees a snapshot of the samples: samples appended by
+  the producer become visible in update(), and the oldest samples
+  of the snapshot are released in discard(). Painting the samples
+  works on the ring buffer itself, without copying them.
+  The bounding rectangle is extended with each update().
+
+  When the buffer is full, append() fails until the consumer
+  has discarded samples.
+
+  \par Example
+  \code
+    class SamplingThread: public QwtSamplingThread
+    {
+    ...
+    protected:
+        virtual void sample( double elapsed )
+        {
+            d_data->append( QPointF( elapsed, readValue() ) );
+        }
+
+        QwtRingBufferData *d_data;
+    };
+
+    // GUI thread, f.e. in a timer event
+    if ( data->update() > 0 )
+        plot->replot();
+  \endcode
+
+  \note All methods, but append() and capacity() have to be called 
+        from the consumer thread.
+*/
+class QWT_EXPORT QwtRingBufferData: public QwtSeriesData<QPointF>
+{
+public:
+    explicit QwtRingBufferData( size_t capacity );
+    virtual ~QwtRingBufferData();
+
+    size_t capacity() const;
+
+    bool append( const QPointF & );
+    size_t append( const QPointF *samples, size_t count );
+
+    size_t update();
+    void discard( size_t count );
+    void clear();
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual QRectF boundingRect() const;
+
+private:
+    Q_DISABLE_COPY(QwtRingBufferData)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
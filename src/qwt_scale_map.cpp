@@ -12,6 +12,106 @@
 #include <qrect.h>
 #include <qdebug.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// number of values, that are converted at once in the float
+// and QPointF versions of the array transformations
+static const int qwtBlockSize = 256;
+
+/*
+  p = p1 + ( s - ts1 ) * cnv
+
+  The vectorized loops use the same operations in the same order
+  as QwtScaleMap::transform( double ), so that the results
+  are identical to the ones of the scalar implementation.
+ */
+static void qwtTransformLinear( double p1, double ts1, double cnv,
+    const double *values, double *result, int count )
+{
+    int i = 0;
+
+#if defined(__AVX__)
+    {
+        const __m256d vp1 = _mm256_set1_pd( p1 );
+        const __m256d vts1 = _mm256_set1_pd( ts1 );
+        const __m256d vcnv = _mm256_set1_pd( cnv );
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m256d v = _mm256_loadu_pd( values + i );
+            v = _mm256_mul_pd( _mm256_sub_pd( v, vts1 ), vcnv );
+            _mm256_storeu_pd( result + i, _mm256_add_pd( vp1, v ) );
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    {
+        const __m128d vp1 = _mm_set1_pd( p1 );
+        const __m128d vts1 = _mm_set1_pd( ts1 );
+        const __m128d vcnv = _mm_set1_pd( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            __m128d v = _mm_loadu_pd( values + i );
+            v = _mm_mul_pd( _mm_sub_pd( v, vts1 ), vcnv );
+            _mm_storeu_pd( result + i, _mm_add_pd( vp1, v ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+        result[i] = p1 + ( values[i] - ts1 ) * cnv;
+}
+
+/*
+  s = ts1 + ( p - p1 ) / cnv
+ */
+static void qwtInvTransformLinear( double p1, double ts1, double cnv,
+    const double *values, double *result, int count )
+{
+    int i = 0;
+
+#if defined(__AVX__)
+    {
+        const __m256d vp1 = _mm256_set1_pd( p1 );
+        const __m256d vts1 = _mm256_set1_pd( ts1 );
+        const __m256d vcnv = _mm256_set1_pd( cnv );
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m256d v = _mm256_loadu_pd( values + i );
+            v = _mm256_div_pd( _mm256_sub_pd( v, vp1 ), vcnv );
+            _mm256_storeu_pd( result + i, _mm256_add_pd( vts1, v ) );
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    {
+        const __m128d vp1 = _mm_set1_pd( p1 );
+        const __m128d vts1 = _mm_set1_pd( ts1 );
+        const __m128d vcnv = _mm_set1_pd( cnv );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            __m128d v = _mm_loadu_pd( values + i );
+            v = _mm_div_pd( _mm_sub_pd( v, vp1 ), vcnv );
+            _mm_storeu_pd( result + i, _mm_add_pd( vts1, v ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+        result[i] = ts1 + ( values[i] - p1 ) / cnv;
+}
+
 /*!
   \brief Constructor
 
@@ -69,6 +169,40 @@ QwtScaleMap &QwtScaleMap::operator=( const QwtScaleMap & other )
     return *this;
 }
 
+/*!
+  \brief Compare 2 maps
+
+  Maps are equal, when their intervals are the same and
+  their transformations are equal according to QwtTransform::isEqual().
+
+  \param other Other map
+  \return true, when both maps map all values to the same positions
+  \sa QwtTransform::isEqual()
+*/
+bool QwtScaleMap::operator==( const QwtScaleMap &other ) const
+{
+    if ( d_s1 != other.d_s1 || d_s2 != other.d_s2
+        || d_p1 != other.d_p1 || d_p2 != other.d_p2 )
+    {
+        return false;
+    }
+
+    if ( d_transform == NULL || other.d_transform == NULL )
+        return d_transform == other.d_transform;
+
+    return d_transform->isEqual( other.d_transform );
+}
+
+/*!
+  \param other Other map
+  \return true, when the maps are not equal
+  \sa operator==()
+*/
+bool QwtScaleMap::operator!=( const QwtScaleMap &other ) const
+{
+    return !( *this == other );
+}
+
 /*!
    Initialize the map with a transformation
 */
@@ -139,6 +273,152 @@ void QwtScaleMap::updateFactor()
         d_cnv = ( d_p2 - d_p1 ) / ( ts2 - d_ts1 );
 }
 
+/*!
+  \brief Transform an array of values from scale to paint coordinates
+
+  The results are the same as calling transform( double ) for each value,
+  but the values are processed by a vectorized implementation
+  ( SSE2/AVX, when enabled by the compiler ) and the transformation
+  is called once for all values ( QwtTransform::transformValues() ).
+
+  \param values Values relative to the coordinates of the scale
+  \param result Array for the transformed values, might be the same as values
+  \param count Number of values
+
+  \sa invTransform()
+*/
+void QwtScaleMap::transform( const double *values,
+    double *result, int count ) const
+{
+    if ( count <= 0 )
+        return;
+
+    if ( d_transform )
+    {
+        d_transform->transformValues( values, result, count );
+        values = result;
+    }
+
+    qwtTransformLinear( d_p1, d_ts1, d_cnv, values, result, count );
+}
+
+/*!
+  \brief Transform an array of values from paint to scale coordinates
+
+  \param values Values relative to the coordinates of the paint device
+  \param result Array for the transformed values, might be the same as values
+  \param count Number of values
+
+  \sa transform()
+*/
+void QwtScaleMap::invTransform( const double *values,
+    double *result, int count ) const
+{
+    if ( count <= 0 )
+        return;
+
+    qwtInvTransformLinear( d_p1, d_ts1, d_cnv, values, result, count );
+
+    if ( d_transform )
+        d_transform->invTransformValues( result, result, count );
+}
+
+/*!
+  \brief Transform an array of float values from scale to paint coordinates
+
+  The calculations are done in double precision.
+
+  \param values Values relative to the coordinates of the scale
+  \param result Array for the transformed values, might be the same as values
+  \param count Number of values
+
+  \sa invTransform()
+*/
+void QwtScaleMap::transform( const float *values,
+    float *result, int count ) const
+{
+    double buffer[ qwtBlockSize ];
+
+    for ( int i = 0; i < count; i += qwtBlockSize )
+    {
+        const int n = qMin( qwtBlockSize, count - i );
+
+        for ( int j = 0; j < n; j++ )
+            buffer[j] = values[i + j];
+
+        transform( buffer, buffer, n );
+
+        for ( int j = 0; j < n; j++ )
+            result[i + j] = static_cast<float>( buffer[j] );
+    }
+}
+
+/*!
+  \brief Transform an array of float values from paint to scale coordinates
+
+  The calculations are done in double precision.
+
+  \param values Values relative to the coordinates of the paint device
+  \param result Array for the transformed values, might be the same as values
+  \param count Number of values
+
+  \sa transform()
+*/
+void QwtScaleMap::invTransform( const float *values,
+    float *result, int count ) const
+{
+    double buffer[ qwtBlockSize ];
+
+    for ( int i = 0; i < count; i += qwtBlockSize )
+    {
+        const int n = qMin( qwtBlockSize, count - i );
+
+        for ( int j = 0; j < n; j++ )
+            buffer[j] = values[i + j];
+
+        invTransform( buffer, buffer, n );
+
+        for ( int j = 0; j < n; j++ )
+            result[i + j] = static_cast<float>( buffer[j] );
+    }
+}
+
+/*!
+   Transform an array of points from scale to paint coordinates
+
+   \param xMap X map
+   \param yMap Y map
+   \param points Positions in scale coordinates
+   \param result Array for the positions in paint coordinates,
+                 might be the same as points
+   \param count Number of points
+
+   \sa transform( const double *, double *, int )
+*/
+void QwtScaleMap::transform( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QPointF *points, QPointF *result, int count )
+{
+    double xValues[ qwtBlockSize ];
+    double yValues[ qwtBlockSize ];
+
+    for ( int i = 0; i < count; i += qwtBlockSize )
+    {
+        const int n = qMin( qwtBlockSize, count - i );
+
+        for ( int j = 0; j < n; j++ )
+        {
+            xValues[j] = points[i + j].x();
+            yValues[j] = points[i + j].y();
+        }
+
+        xMap.transform( xValues, xValues, n );
+        yMap.transform( yValues, yValues, n );
+
+        for ( int j = 0; j < n; j++ )
+            result[i + j] = QPointF( xValues[j], yValues[j] );
+    }
+}
+
 /*!
    Transform a rectangle from scale to paint coordinates
 
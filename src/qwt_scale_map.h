@@ -37,6 +37,9 @@ public:
 
     QwtScaleMap &operator=( const QwtScaleMap & );
 
+    bool operator==( const QwtScaleMap & ) const;
+    bool operator!=( const QwtScaleMap & ) const;
+
     void setTransformation( QwtTransform * );
     const QwtTransform *transformation() const;
 
@@ -46,6 +49,12 @@ public:
     double transform( double s ) const;
     double invTransform( double p ) const;
 
+    void transform( const double *values, double *result, int count ) const;
+    void invTransform( const double *values, double *result, int count ) const;
+
+    void transform( const float *values, float *result, int count ) const;
+    void invTransform( const float *values, float *result, int count ) const;
+
     double p1() const;
     double p2() const;
 
@@ -65,6 +74,9 @@ public:
     static QPointF invTransform( const QwtScaleMap &,
         const QwtScaleMap &, const QPointF & );
 
+    static void transform( const QwtScaleMap &, const QwtScaleMap &,
+        const QPointF *points, QPointF *result, int count );
+
     bool isInverting() const;
 
 private:
@@ -83,21 +83,24 @@ QRectF qwtBoundingRectT(
     if ( to < from )
         return boundingRect;
 
-    int i;
-    for ( i = from; i <= to; i++ )
+    if ( series.rangeBoundingRect( from, to, boundingRect ) )
+        return boundingRect;
+
+    QwtSeriesReader<T> reader( series, from, to );
+
+    while ( reader.hasNext() )
     {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
+        const QRectF rect = qwtBoundingRect( reader.next() );
         if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
         {
             boundingRect = rect;
-            i++;
             break;
         }
     }
 
-    for ( ; i <= to; i++ )
+    while ( reader.hasNext() )
     {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
+        const QRectF rect = qwtBoundingRect( reader.next() );
         if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
         {
             boundingRect.setLeft( qMin( boundingRect.left(), rect.left() ) );
@@ -215,6 +218,101 @@ QRectF qwtBoundingRect(
     return qwtBoundingRectT<QwtSetSample>( series, from, to );
 }
 
+//! Constructor, initializing an empty tree
+QwtBoundingRectTree::QwtBoundingRectTree():
+    d_numSamples( 0 )
+{
+}
+
+/*!
+  \brief Clear the tree
+  \sa build()
+ */
+void QwtBoundingRectTree::reset()
+{
+    d_numSamples = 0;
+    d_levels.clear();
+}
+
+/*!
+  \return Number of samples of the series, the tree has been built for
+  \sa build()
+ */
+size_t QwtBoundingRectTree::size() const
+{
+    return d_numSamples;
+}
+
+void QwtBoundingRectTree::build( const QVector<QRectF> &blockRects )
+{
+    d_levels.clear();
+
+    if ( blockRects.isEmpty() )
+        return;
+
+    QVector<QRectF> level = blockRects;
+    d_levels += level;
+
+    while ( level.size() >= 2 )
+    {
+        QVector<QRectF> upper( level.size() / 2 );
+        for ( int i = 0; i < upper.size(); i++ )
+            upper[i] = united( level[2 * i], level[2 * i + 1] );
+
+        d_levels += upper;
+        level = upper;
+    }
+}
+
+QRectF QwtBoundingRectTree::blockBoundingRect( 
+    int fromBlock, int toBlock ) const
+{
+    QRectF rect( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    int i = fromBlock;
+    while ( i <= toBlock )
+    {
+        // the largest aligned node, that fits into the range
+
+        int level = 0;
+        int numBlocks = 1;
+
+        while ( level + 1 < d_levels.size()
+            && ( i % ( 2 * numBlocks ) ) == 0
+            && i + 2 * numBlocks - 1 <= toBlock )
+        {
+            level++;
+            numBlocks *= 2;
+        }
+
+        rect = united( rect, d_levels[level][i / numBlocks] );
+        i += numBlocks;
+    }
+
+    return rect;
+}
+
+/*
+  QRectF::united() ignores rectangles without a size, but the 
+  bounding rectangle of a single point has a width and height of 0.
+ */
+QRectF QwtBoundingRectTree::united( const QRectF &rect1, const QRectF &rect2 )
+{
+    if ( rect2.width() < 0.0 || rect2.height() < 0.0 )
+        return rect1;
+
+    if ( rect1.width() < 0.0 || rect1.height() < 0.0 )
+        return rect2;
+
+    QRectF rect;
+    rect.setCoords( qMin( rect1.left(), rect2.left() ),
+        qMin( rect1.top(), rect2.top() ),
+        qMax( rect1.right(), rect2.right() ),
+        qMax( rect1.bottom(), rect2.bottom() ) );
+
+    return rect;
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -241,6 +339,12 @@ QRectF QwtPointSeriesData::boundingRect() const
     return d_boundingRect;
 }
 
+//! \sa QwtSeriesData::rangeBoundingRect(), setRangeIndexEnabled()
+bool QwtPointSeriesData::rangeBoundingRect( int from, int to, QRectF &rect ) const
+{
+    return indexedBoundingRect( from, to, rect );
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -267,6 +371,12 @@ QRectF QwtPoint3DSeriesData::boundingRect() const
     return d_boundingRect;
 }
 
+//! \sa QwtSeriesData::rangeBoundingRect(), setRangeIndexEnabled()
+bool QwtPoint3DSeriesData::rangeBoundingRect( int from, int to, QRectF &rect ) const
+{
+    return indexedBoundingRect( from, to, rect );
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -293,6 +403,12 @@ QRectF QwtIntervalSeriesData::boundingRect() const
     return d_boundingRect;
 }
 
+//! \sa QwtSeriesData::rangeBoundingRect(), setRangeIndexEnabled()
+bool QwtIntervalSeriesData::rangeBoundingRect( int from, int to, QRectF &rect ) const
+{
+    return indexedBoundingRect( from, to, rect );
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -319,6 +435,12 @@ QRectF QwtSetSeriesData::boundingRect() const
     return d_boundingRect;
 }
 
+//! \sa QwtSeriesData::rangeBoundingRect(), setRangeIndexEnabled()
+bool QwtSetSeriesData::rangeBoundingRect( int from, int to, QRectF &rect ) const
+{
+    return indexedBoundingRect( from, to, rect );
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -344,3 +466,9 @@ QRectF QwtTradingChartData::boundingRect() const
 
     return d_boundingRect;
 }
+
+//! \sa QwtSeriesData::rangeBoundingRect(), setRangeIndexEnabled()
+bool QwtTradingChartData::rangeBoundingRect( int from, int to, QRectF &rect ) const
+{
+    return indexedBoundingRect( from, to, rect );
+}
@@ -17,6 +17,8 @@
 #include <qvector.h>
 #include <qrect.h>
 
+class QwtScaleMap;
+
 /*!
    \brief Abstract interface for iterating over samples
 
@@ -90,6 +92,86 @@ public:
     */
     virtual void setRectOfInterest( const QRectF &rect );
 
+    /*!
+       Reduce a range of samples to those, that are relevant
+       for the current resolution
+
+       Series, that can identify the samples affecting the pixels of
+       a polyline without iterating over all of them ( f.e. QwtPointPyramidData ),
+       can implement this method. QwtPlotCurve uses it to draw lines
+       at costs, that depend on the width of the canvas instead of
+       the number of samples.
+
+       The default implementation does nothing.
+
+       \param xMap Maps x-values into pixel coordinates
+       \param from Index of the first sample
+       \param to Index of the last sample
+       \param indices Indices of the samples, that have to be painted
+
+       \return true, when indices has been filled
+     */
+    virtual bool levelOfDetail( const QwtScaleMap &xMap,
+        int from, int to, QVector<int> &indices ) const;
+
+    /*!
+       Calculate the bounding rectangle of a range of samples
+
+       Series, that can find the bounds of a range without iterating
+       over all of its samples ( f.e. QwtArraySeriesData with an enabled
+       range index ), can implement this method. It is used by qwtBoundingRect().
+
+       The default implementation does nothing.
+
+       \param from Index of the first sample
+       \param to Index of the last sample
+       \param rect Bounding rectangle of the samples
+
+       \return true, when rect has been calculated
+     */
+    virtual bool rangeBoundingRect( int from, int to, QRectF &rect ) const;
+
+    /*!
+       Copy a block of samples into a buffer
+
+       Algorithms iterating over many samples ( f.e. QwtPointMapper
+       or qwtBoundingRect() ) read the samples in blocks, to avoid
+       the costs of calling sample() for each of them.
+
+       The default implementation calls sample() for each index.
+       Series with a contiguous storage should implement something faster.
+
+       \param from Index of the first sample
+       \param count Number of samples to copy
+       \param samples Buffer with space for at least count samples
+
+       \sa QwtSeriesReader
+     */
+    virtual void copySamples( size_t from, size_t count, T *samples ) const;
+
+    /*!
+       Copy a block of samples, mapped into paint device coordinates
+
+       Series, that can map their samples faster than transforming
+       the result of copySamples() ( f.e. QwtSharedXColumnData, where
+       the mapped x values are cached for all curves sharing them ),
+       can implement this method. It is used by QwtPointMapper for
+       QPointF samples.
+
+       The default implementation does nothing.
+
+       \param xMap Maps x-values into paint device coordinates
+       \param yMap Maps y-values into paint device coordinates
+       \param from Index of the first sample
+       \param count Number of samples to copy
+       \param samples Buffer with space for at least count samples
+
+       \return true, when samples has been filled
+     */
+    virtual bool copyMappedSamples( 
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        size_t from, size_t count, T *samples ) const;
+
 protected:
     //! Can be used to cache a calculated bounding rectangle
     mutable QRectF d_boundingRect;
@@ -114,11 +196,259 @@ void QwtSeriesData<T>::setRectOfInterest( const QRectF & )
 {
 }
 
+template <typename T>
+bool QwtSeriesData<T>::levelOfDetail( const QwtScaleMap &,
+    int, int, QVector<int> & ) const
+{
+    return false;
+}
+
+template <typename T>
+bool QwtSeriesData<T>::rangeBoundingRect( int, int, QRectF & ) const
+{
+    return false;
+}
+
+template <typename T>
+bool QwtSeriesData<T>::copyMappedSamples( const QwtScaleMap &,
+    const QwtScaleMap &, size_t, size_t, T * ) const
+{
+    return false;
+}
+
+template <typename T>
+void QwtSeriesData<T>::copySamples(
+    size_t from, size_t count, T *samples ) const
+{
+    for ( size_t i = 0; i < count; i++ )
+        samples[i] = sample( from + i );
+}
+
+/*!
+  \brief Sequential access to a range of samples
+
+  QwtSeriesReader reads the samples of a series in blocks
+  using QwtSeriesData::copySamples(). It is intended for loops
+  iterating over many samples, where calling the virtual
+  QwtSeriesData::sample() for each sample is too expensive.
+
+  \code
+QwtSeriesReader<QPointF> reader( *series, from, to );
+while ( reader.hasNext() )
+{
+    const QPointF &sample = reader.next();
+    ...
+}
+  \endcode
+ */
+template <typename T>
+class QwtSeriesReader
+{
+public:
+    //! Number of samples, that are read at once
+    enum { BufferSize = 256 };
+
+    /*!
+       Constructor
+
+       \param series Series
+       \param from Index of the first sample
+       \param to Index of the last sample
+     */
+    QwtSeriesReader( const QwtSeriesData<T> &series, int from, int to ):
+        d_series( series ),
+        d_index( from ),
+        d_to( to ),
+        d_pos( 0 ),
+        d_count( 0 )
+    {
+    }
+
+    //! \return true, when there are samples left
+    inline bool hasNext() const
+    {
+        return ( d_pos < d_count ) || ( d_index <= d_to );
+    }
+
+    /*!
+       \return The next sample
+       \warning Calling next() without checking hasNext() is undefined
+     */
+    inline const T &next()
+    {
+        if ( d_pos == d_count )
+            fetch();
+
+        return d_buffer[ d_pos++ ];
+    }
+
+private:
+    void fetch()
+    {
+        d_count = qMin( static_cast<int>( BufferSize ), d_to - d_index + 1 );
+        d_series.copySamples( d_index, d_count, d_buffer );
+
+        d_index += d_count;
+        d_pos = 0;
+    }
+
+    const QwtSeriesData<T> &d_series;
+
+    int d_index;
+    const int d_to;
+
+    int d_pos;
+    int d_count;
+
+    T d_buffer[ BufferSize ];
+};
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QPointF> &, int from = 0, int to = -1 );
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QwtPoint3D> &, int from = 0, int to = -1 );
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QwtPointPolar> &, int from = 0, int to = -1 );
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QwtIntervalSample> &, int from = 0, int to = -1 );
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QwtSetSample> &, int from = 0, int to = -1 );
+
+QWT_EXPORT QRectF qwtBoundingRect(
+    const QwtSeriesData<QwtOHLCSample> &, int from = 0, int to = -1 );
+
+/*!
+  \brief A segment tree of bounding rectangles
+
+  QwtBoundingRectTree stores the bounding rectangles of blocks of
+  BlockSize samples. Each following level unites 2 rectangles of
+  the previous one, so that the bounding rectangle of any range
+  of samples can be found in O(log(n)).
+
+  The tree is built from the qwtBoundingRect() of each block, so it
+  can be used for all types of samples, where qwtBoundingRect() is 
+  available. The series needs to be passed to all methods, that
+  have to read samples.
+
+  \sa QwtArraySeriesData::setRangeIndexEnabled()
+*/
+class QWT_EXPORT QwtBoundingRectTree
+{
+public:
+    //! Number of samples, that are summarized by a rectangle of the lowest level
+    enum { BlockSize = 64 };
+
+    QwtBoundingRectTree();
+
+    template <typename T>
+    void build( const QwtSeriesData<T> &series );
+
+    void reset();
+    size_t size() const;
+
+    template <typename T>
+    QRectF boundingRect( const QwtSeriesData<T> &series, int from, int to ) const;
+
+private:
+    void build( const QVector<QRectF> &blockRects );
+    QRectF blockBoundingRect( int fromBlock, int toBlock ) const;
+
+    static QRectF united( const QRectF &, const QRectF & );
+
+    size_t d_numSamples;
+    QVector< QVector<QRectF> > d_levels;
+};
+
+/*!
+  \brief Build the tree for a series
+
+  All samples of the series are read once. The tree needs memory
+  for about 2 * n / BlockSize rectangles.
+
+  \param series Series
+  \sa reset()
+ */
+template <typename T>
+void QwtBoundingRectTree::build( const QwtSeriesData<T> &series )
+{
+    const size_t numSamples = series.size();
+    const int numBlocks = static_cast<int>( numSamples / BlockSize );
+
+    QVector<QRectF> blockRects( numBlocks );
+    for ( int i = 0; i < numBlocks; i++ )
+    {
+        blockRects[i] = qwtBoundingRect( series, 
+            i * BlockSize, ( i + 1 ) * BlockSize - 1 );
+    }
+
+    build( blockRects );
+    d_numSamples = numSamples;
+}
+
+/*!
+  \brief Calculate the bounding rectangle of a range of samples
+
+  The samples in front of the first and behind the last complete
+  block are read from the series, the rectangles of the blocks 
+  in between are taken from the tree.
+
+  \param series Series, the tree has been built for
+  \param from Index of the first sample
+  \param to Index of the last sample
+
+  \return Bounding rectangle, or an invalid rectangle, when the 
+          tree doesn't match the series
+ */
+template <typename T>
+QRectF QwtBoundingRectTree::boundingRect( 
+    const QwtSeriesData<T> &series, int from, int to ) const
+{
+    if ( series.size() != d_numSamples || from < 0 || from > to 
+        || static_cast<size_t>( to ) >= d_numSamples )
+    {
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+    }
+
+    const int fromBlock = ( from + BlockSize - 1 ) / BlockSize;
+    const int toBlock = ( to + 1 ) / BlockSize - 1;
+
+    if ( fromBlock > toBlock )
+        return qwtBoundingRect( series, from, to );
+
+    QRectF rect = blockBoundingRect( fromBlock, toBlock );
+
+    if ( from < fromBlock * BlockSize )
+    {
+        rect = united( rect, 
+            qwtBoundingRect( series, from, fromBlock * BlockSize - 1 ) );
+    }
+
+    if ( to >= ( toBlock + 1 ) * BlockSize )
+    {
+        rect = united( rect,
+            qwtBoundingRect( series, ( toBlock + 1 ) * BlockSize, to ) );
+    }
+
+    return rect;
+}
+
 /*!
   \brief Template class for data, that is organized as QVector
 
   QVector uses implicit data sharing and can be
   passed around as argument efficiently.
+
+  Painting, bounding rectangles and QwtPlotCurve::closestPoint()
+  read the samples with copySamples(). As derived classes might overload
+  sample() to modify the samples, copySamples() calls sample() for each
+  sample, unless reading the array directly has been enabled by
+  setBlockCopyEnabled(). 
+
+  \sa setBlockCopyEnabled()
 */
 template <typename T>
 class QwtArraySeriesData: public QwtSeriesData<T>
@@ -153,19 +483,49 @@ public:
     */
     virtual T sample( size_t index ) const;
 
+    /*!
+      Copy a block of samples into a buffer
+
+      When isBlockCopyEnabled() the samples are copied from the array 
+      without calling sample().
+
+      \param from Index of the first sample
+      \param count Number of samples to copy
+      \param samples Buffer with space for at least count samples
+    */
+    virtual void copySamples( size_t from,
+        size_t count, T *samples ) const;
+
+    void setBlockCopyEnabled( bool on );
+    bool isBlockCopyEnabled() const;
+
+    void setRangeIndexEnabled( bool on );
+    bool isRangeIndexEnabled() const;
+
 protected:
+    bool indexedBoundingRect( int from, int to, QRectF &rect ) const;
+
     //! Vector of samples
     QVector<T> d_samples;
+
+private:
+    bool d_blockCopyEnabled;
+    bool d_rangeIndexEnabled;
+    mutable QwtBoundingRectTree d_rangeIndex;
 };
 
 template <typename T>
-QwtArraySeriesData<T>::QwtArraySeriesData()
+QwtArraySeriesData<T>::QwtArraySeriesData():
+    d_blockCopyEnabled( false ),
+    d_rangeIndexEnabled( false )
 {
 }
 
 template <typename T>
 QwtArraySeriesData<T>::QwtArraySeriesData( const QVector<T> &samples ):
-    d_samples( samples )
+    d_samples( samples ),
+    d_blockCopyEnabled( false ),
+    d_rangeIndexEnabled( false )
 {
 }
 
@@ -173,9 +533,101 @@ template <typename T>
 void QwtArraySeriesData<T>::setSamples( const QVector<T> &samples )
 {
     QwtSeriesData<T>::d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+    d_rangeIndex.reset();
+
     d_samples = samples;
 }
 
+/*!
+  \brief En/Disable reading the array directly in copySamples()
+
+  Copying the samples from the array is much faster than calling
+  the virtual sample() for each of them. But it is only correct
+  as long as sample() is not overloaded to modify the samples, what
+  is the reason why it is disabled by default.
+
+  QwtPlotCurve::setSamples() enables it for the QwtPointSeriesData
+  objects it creates.
+
+  \param on On/Off
+  \sa isBlockCopyEnabled(), copySamples()
+*/
+template <typename T>
+void QwtArraySeriesData<T>::setBlockCopyEnabled( bool on )
+{
+    d_blockCopyEnabled = on;
+}
+
+/*!
+  \return True, when copySamples() reads the array directly
+  \sa setBlockCopyEnabled()
+*/
+template <typename T>
+bool QwtArraySeriesData<T>::isBlockCopyEnabled() const
+{
+    return d_blockCopyEnabled;
+}
+
+/*!
+  \brief En/Disable an index for the bounding rectangles of ranges
+
+  When enabled, qwtBoundingRect() for a range of samples is calculated
+  in O(log(n)) using a QwtBoundingRectTree, that is built on the first
+  request after the samples have been changed.
+
+  The index is supported by the derived classes for the sample types
+  of Qwt - like QwtPointSeriesData or QwtTradingChartData -
+  implementing QwtSeriesData::rangeBoundingRect().
+
+  \param on On/Off
+  \sa isRangeIndexEnabled(), rangeBoundingRect()
+*/
+template <typename T>
+void QwtArraySeriesData<T>::setRangeIndexEnabled( bool on )
+{
+    d_rangeIndexEnabled = on;
+
+    if ( !on )
+        d_rangeIndex.reset();
+}
+
+/*!
+  \return True, when the range index is enabled
+  \sa setRangeIndexEnabled()
+*/
+template <typename T>
+bool QwtArraySeriesData<T>::isRangeIndexEnabled() const
+{
+    return d_rangeIndexEnabled;
+}
+
+/*!
+  \brief Calculate the bounding rectangle of a range of samples using the range index
+
+  \param from Index of the first sample
+  \param to Index of the last sample
+  \param rect Bounding rectangle of the samples
+
+  \return false, when the range index is disabled or the
+          range is too small to benefit from it
+  \sa setRangeIndexEnabled(), QwtSeriesData::rangeBoundingRect()
+*/
+template <typename T>
+bool QwtArraySeriesData<T>::indexedBoundingRect( 
+    int from, int to, QRectF &rect ) const
+{
+    // small ranges - like the blocks of the tree - are scanned
+
+    if ( !d_rangeIndexEnabled || to - from < 2 * QwtBoundingRectTree::BlockSize )
+        return false;
+
+    if ( d_rangeIndex.size() != size() )
+        d_rangeIndex.build( *this );
+
+    rect = d_rangeIndex.boundingRect( *this, from, to );
+    return true;
+}
+
 template <typename T>
 const QVector<T> QwtArraySeriesData<T>::samples() const
 {
@@ -194,6 +646,21 @@ T QwtArraySeriesData<T>::sample( size_t i ) const
     return d_samples[ static_cast<int>( i ) ];
 }
 
+template <typename T>
+void QwtArraySeriesData<T>::copySamples(
+    size_t from, size_t count, T *samples ) const
+{
+    if ( !d_blockCopyEnabled )
+    {
+        QwtSeriesData<T>::copySamples( from, count, samples );
+        return;
+    }
+
+    const T *values = d_samples.constData() + from;
+    for ( size_t i = 0; i < count; i++ )
+        samples[i] = values[i];
+}
+
 //! Interface for iterating over an array of points
 class QWT_EXPORT QwtPointSeriesData: public QwtArraySeriesData<QPointF>
 {
@@ -202,6 +669,7 @@ public:
         const QVector<QPointF> & = QVector<QPointF>() );
 
     virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
 };
 
 //! Interface for iterating over an array of 3D points
@@ -211,6 +679,7 @@ public:
     QwtPoint3DSeriesData(
         const QVector<QwtPoint3D> & = QVector<QwtPoint3D>() );
     virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
 };
 
 //! Interface for iterating over an array of intervals
@@ -221,6 +690,7 @@ public:
         const QVector<QwtIntervalSample> & = QVector<QwtIntervalSample>() );
 
     virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
 };
 
 //! Interface for iterating over an array of samples
@@ -231,6 +701,7 @@ public:
         const QVector<QwtSetSample> & = QVector<QwtSetSample>() );
 
     virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
 };
 
 /*!
@@ -243,26 +714,9 @@ public:
         const QVector<QwtOHLCSample> & = QVector<QwtOHLCSample>() );
 
     virtual QRectF boundingRect() const;
+    virtual bool rangeBoundingRect( int from, int to, QRectF & ) const;
 };
 
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QPointF> &, int from = 0, int to = -1 );
-
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QwtPoint3D> &, int from = 0, int to = -1 );
-
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QwtPointPolar> &, int from = 0, int to = -1 );
-
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QwtIntervalSample> &, int from = 0, int to = -1 );
-
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QwtSetSample> &, int from = 0, int to = -1 );
-
-QWT_EXPORT QRectF qwtBoundingRect(
-    const QwtSeriesData<QwtOHLCSample> &, int from = 0, int to = -1 );
-
 /*!
     Binary search for a sorted series of samples
 
@@ -0,0 +1,730 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_series_loader.h"
+#include "qwt_plot_curve.h"
+#include "qwt_plot.h"
+#include "qwt_system_clock.h"
+#include <qfile.h>
+#include <qmutex.h>
+#include <qbitarray.h>
+#include <qevent.h>
+#include <string.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+static inline bool qwtIsSpace( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/*
+  Parsing a number in the C locale. Numbers with up to 15 significant
+  digits and small exponents are calculated exactly from an integer
+  mantissa and a power of 10. All others are parsed by Qt.
+ */
+static bool qwtParseNumber( const char *begin, const char *end, double &value )
+{
+    static const double powersOf10[] = 
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 
+        1e21, 1e22
+    };
+
+    while ( begin < end && qwtIsSpace( *begin ) )
+        begin++;
+
+    while ( end > begin && qwtIsSpace( end[-1] ) )
+        end--;
+
+    if ( begin == end )
+        return false;
+
+    const char *p = begin;
+
+    bool negative = false;
+    if ( *p == '-' || *p == '+' )
+    {
+        negative = ( *p == '-' );
+        p++;
+    }
+
+    quint64 mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+
+    while ( p < end && *p >= '0' && *p <= '9' )
+    {
+        hasDigits = true;
+
+        if ( mantissa < 100000000000000000ULL )
+        {
+            mantissa = 10 * mantissa + ( *p - '0' );
+            if ( mantissa > 0 )
+                numDigits++;
+        }
+        else
+        {
+            exponent++;
+        }
+
+        p++;
+    }
+
+    if ( p < end && *p == '.' )
+    {
+        p++;
+
+        while ( p < end && *p >= '0' && *p <= '9' )
+        {
+            hasDigits = true;
+
+            if ( mantissa < 100000000000000000ULL )
+            {
+                mantissa = 10 * mantissa + ( *p - '0' );
+                if ( mantissa > 0 )
+                    numDigits++;
+
+                exponent--;
+            }
+
+            p++;
+        }
+    }
+
+    if ( hasDigits && p < end && ( *p == 'e' || *p == 'E' ) )
+    {
+        p++;
+
+        bool negativeExponent = false;
+        if ( p < end && ( *p == '-' || *p == '+' ) )
+        {
+            negativeExponent = ( *p == '-' );
+            p++;
+        }
+
+        if ( p == end || *p < '0' || *p > '9' )
+            hasDigits = false;
+
+        int e = 0;
+        while ( p < end && *p >= '0' && *p <= '9' && e < 100000 )
+        {
+            e = 10 * e + ( *p - '0' );
+            p++;
+        }
+
+        exponent += negativeExponent ? -e : e;
+    }
+
+    if ( hasDigits && p == end && numDigits <= 15 && qAbs( exponent ) <= 22 )
+    {
+        // both operands are exact, so the result is rounded correctly
+
+        value = static_cast<double>( mantissa );
+        if ( exponent >= 0 )
+            value *= powersOf10[ exponent ];
+        else
+            value /= powersOf10[ -exponent ];
+
+        if ( negative )
+            value = -value;
+
+        return true;
+    }
+
+    // "nan", "inf", many digits ...
+
+    bool ok;
+    value = QByteArray( begin, static_cast<int>( end - begin ) ).toDouble( &ok );
+
+    return ok;
+}
+
+class QwtParseCommand
+{
+public:
+    const char *begin;
+    const char *end;
+
+    QwtSeriesLoader::Format format;
+
+    int xColumn;
+    int yColumn;
+    char separator;
+};
+
+class QwtParseResults
+{
+public:
+    QwtParseResults():
+        isCancelled( false )
+    {
+    }
+
+    QMutex mutex;
+    bool isCancelled;
+
+    QVector< QVector<QPointF> > blocks;
+    QBitArray isDone;
+};
+
+static void qwtParseCsv( const QwtParseCommand &command, 
+    QVector<QPointF> &samples )
+{
+    const char *p = command.begin;
+    const char *end = command.end;
+
+    int numLines = 0;
+    for ( const char *q = p; q < end; q++ )
+    {
+        q = static_cast<const char *>( ::memchr( q, '\n', end - q ) );
+        if ( q == NULL )
+            break;
+
+        numLines++;
+    }
+
+    samples.reserve( numLines + 1 );
+
+    const int lastColumn = qMax( command.xColumn, command.yColumn );
+    const bool isWhiteSpace = qwtIsSpace( command.separator );
+
+    while ( p < end )
+    {
+        const char *lineEnd = static_cast<const char *>( 
+            ::memchr( p, '\n', end - p ) );
+
+        if ( lineEnd == NULL )
+            lineEnd = end;
+
+        const char *fields[2][2] = { { NULL, NULL }, { NULL, NULL } };
+
+        const char *q = p;
+        if ( isWhiteSpace )
+        {
+            while ( q < lineEnd && qwtIsSpace( *q ) )
+                q++;
+        }
+
+        for ( int column = 0; column <= lastColumn && q <= lineEnd; column++ )
+        {
+            const char *fieldEnd = q;
+            if ( isWhiteSpace )
+            {
+                while ( fieldEnd < lineEnd && !qwtIsSpace( *fieldEnd ) )
+                    fieldEnd++;
+            }
+            else
+            {
+                while ( fieldEnd < lineEnd && *fieldEnd != command.separator )
+                    fieldEnd++;
+            }
+
+            if ( column == command.xColumn )
+            {
+                fields[0][0] = q;
+                fields[0][1] = fieldEnd;
+            }
+
+            if ( column == command.yColumn )
+            {
+                fields[1][0] = q;
+                fields[1][1] = fieldEnd;
+            }
+
+            q = fieldEnd + 1;
+            if ( isWhiteSpace )
+            {
+                while ( q < lineEnd && qwtIsSpace( *q ) )
+                    q++;
+            }
+        }
+
+        // a negative x column means, that the x values are 
+        // the indices of the samples, what is filled in later
+
+        double x = 0.0;
+        double y;
+
+        if ( ( command.xColumn < 0 || ( fields[0][0] 
+                && qwtParseNumber( fields[0][0], fields[0][1], x ) ) )
+            && fields[1][0] && qwtParseNumber( fields[1][0], fields[1][1], y ) )
+        {
+            samples += QPointF( x, y );
+        }
+
+        p = lineEnd + 1;
+    }
+}
+
+template <typename Value>
+static void qwtParseBinary( const QwtParseCommand &command, 
+    QVector<QPointF> &samples )
+{
+    const int numSamples = static_cast<int>( 
+        ( command.end - command.begin ) / ( 2 * sizeof( Value ) ) );
+
+    samples.resize( numSamples );
+
+    Value values[2];
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        // the mapped memory might not be aligned
+        ::memcpy( values, command.begin + i * sizeof( values ), sizeof( values ) );
+
+        samples[i].rx() = values[0];
+        samples[i].ry() = values[1];
+    }
+}
+
+static void qwtParseBlock( const QwtParseCommand &command, 
+    QwtParseResults *results, int block )
+{
+    {
+        QMutexLocker locker( &results->mutex );
+        if ( results->isCancelled )
+            return;
+    }
+
+    QVector<QPointF> samples;
+
+    switch( command.format )
+    {
+        case QwtSeriesLoader::BinaryDouble:
+            qwtParseBinary<double>( command, samples );
+            break;
+
+        case QwtSeriesLoader::BinaryFloat:
+            qwtParseBinary<float>( command, samples );
+            break;
+
+        default:
+            qwtParseCsv( command, samples );
+    }
+
+    QMutexLocker locker( &results->mutex );
+
+    results->blocks[block] = samples;
+    results->isDone.setBit( block );
+}
+
+class QwtSeriesLoader::PrivateData
+{
+public:
+    PrivateData():
+        format( QwtSeriesLoader::Csv ),
+        xColumn( 0 ),
+        yColumn( 1 ),
+        separator( ',' ),
+        updateInterval( 100 ),
+        curve( NULL ),
+        data( NULL ),
+        results( NULL ),
+        numPublished( 0 ),
+        numSamples( 0 ),
+        timerId( 0 )
+    {
+    }
+
+    QwtSeriesLoader::Format format;
+    int xColumn;
+    int yColumn;
+    char separator;
+    int updateInterval;
+
+    QwtPlotCurve *curve;
+
+    QFile file;
+    uchar *data;
+
+    // block i is [ boundaries[i], boundaries[i+1] [
+    QVector<qint64> boundaries;
+
+    QwtParseCommand command;
+    QwtParseResults *results;
+
+    int numPublished;
+    int numSamples;
+
+#if QWT_USE_THREADS
+    QList< QFuture<void> > futures;
+#else
+    int numParsed;
+#endif
+
+    int timerId;
+};
+
+/*!
+  Constructor
+  \param parent Parent object
+ */
+QwtSeriesLoader::QwtSeriesLoader( QObject *parent ):
+    QObject( parent )
+{
+    d_data = new PrivateData();
+}
+
+//! Destructor, cancels loading
+QwtSeriesLoader::~QwtSeriesLoader()
+{
+    cancel();
+    delete d_data;
+}
+
+/*!
+  Set the format of the file
+
+  \param format Format
+  \sa format(), load()
+ */
+void QwtSeriesLoader::setFormat( Format format )
+{
+    d_data->format = format;
+}
+
+/*!
+  \return Format of the file
+  \sa setFormat()
+ */
+QwtSeriesLoader::Format QwtSeriesLoader::format() const
+{
+    return d_data->format;
+}
+
+/*!
+  Set the columns of the x and y values in a CSV file
+
+  \param xColumn Column of the x values. When negative the indices 
+                 of the samples are taken as x values.
+  \param yColumn Column of the y values
+ */
+void QwtSeriesLoader::setColumns( int xColumn, int yColumn )
+{
+    d_data->xColumn = xColumn;
+    d_data->yColumn = qMax( yColumn, 0 );
+}
+
+//! \return Column of the x values
+int QwtSeriesLoader::xColumn() const
+{
+    return d_data->xColumn;
+}
+
+//! \return Column of the y values
+int QwtSeriesLoader::yColumn() const
+{
+    return d_data->yColumn;
+}
+
+/*!
+  Set the separator of the values in a CSV file
+
+  When the separator is a space or a tab, any sequence of
+  spaces and tabs separates the values.
+
+  \param separator Separator, the default setting is ','
+ */
+void QwtSeriesLoader::setSeparator( char separator )
+{
+    d_data->separator = separator;
+}
+
+//! \return Separator of the values in a CSV file
+char QwtSeriesLoader::separator() const
+{
+    return d_data->separator;
+}
+
+/*!
+  Set the interval, in which loaded samples are appended to the curve
+
+  \param ms Interval in milliseconds, the default setting is 100
+  \sa updateInterval()
+ */
+void QwtSeriesLoader::setUpdateInterval( int ms )
+{
+    d_data->updateInterval = qMax( ms, 10 );
+}
+
+/*!
+  \return Interval, in which loaded samples are appended to the curve
+  \sa setUpdateInterval()
+ */
+int QwtSeriesLoader::updateInterval() const
+{
+    return d_data->updateInterval;
+}
+
+/*!
+  \brief Start loading a file
+
+  The samples of the curve are removed and replaced by the 
+  samples of the file, while they are loaded.
+
+  \param fileName Name of the file
+  \param curve Curve
+
+  \return false, when the file can't be opened
+  \sa cancel(), isLoading(), finished()
+ */
+bool QwtSeriesLoader::load( const QString &fileName, QwtPlotCurve *curve )
+{
+    cancel();
+
+    PrivateData *d = d_data;
+
+    if ( curve == NULL )
+        return false;
+
+    d->file.setFileName( fileName );
+    if ( !d->file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const qint64 size = d->file.size();
+    if ( size > 0 )
+    {
+        d->data = d->file.map( 0, size );
+        if ( d->data == NULL )
+        {
+            d->file.close();
+            return false;
+        }
+    }
+
+    d->curve = curve;
+    d->curve->setSamples( QVector<QPointF>() );
+
+    // splitting the file into blocks
+
+    d->boundaries.clear();
+    d->boundaries += 0;
+
+    if ( d->format == Csv )
+    {
+        const char *text = reinterpret_cast<const char *>( d->data );
+
+        qint64 pos = 0;
+        while ( pos < size )
+        {
+            qint64 next = qMin( pos + BlockSize, size );
+            if ( next < size )
+            {
+                const void *lineEnd = 
+                    ::memchr( text + next, '\n', size - next );
+
+                next = lineEnd ? ( static_cast<const char *>( lineEnd ) - text + 1 ) : size;
+            }
+
+            d->boundaries += next;
+            pos = next;
+        }
+    }
+    else
+    {
+        const qint64 sampleSize = ( d->format == BinaryDouble )
+            ? 2 * sizeof( double ) : 2 * sizeof( float );
+
+        const qint64 blockSize = ( BlockSize / sampleSize ) * sampleSize;
+        const qint64 end = ( size / sampleSize ) * sampleSize;
+
+        for ( qint64 pos = blockSize; pos < end; pos += blockSize )
+            d->boundaries += pos;
+
+        if ( end > 0 )
+            d->boundaries += end;
+    }
+
+    const int numBlocks = d->boundaries.size() - 1;
+
+    d->command.format = d->format;
+    d->command.xColumn = d->xColumn;
+    d->command.yColumn = d->yColumn;
+    d->command.separator = d->separator;
+
+    d->results = new QwtParseResults();
+    d->results->blocks.resize( numBlocks );
+    d->results->isDone = QBitArray( numBlocks );
+
+    d->numPublished = 0;
+    d->numSamples = 0;
+
+#if QWT_USE_THREADS
+    const char *text = reinterpret_cast<const char *>( d->data );
+
+    for ( int i = 0; i < numBlocks; i++ )
+    {
+        QwtParseCommand command = d->command;
+        command.begin = text + d->boundaries[i];
+        command.end = text + d->boundaries[i + 1];
+
+        d->futures += QtConcurrent::run( 
+            &qwtParseBlock, command, d->results, i );
+    }
+#else
+    d->numParsed = 0;
+#endif
+
+    d->timerId = startTimer( d->updateInterval );
+
+    return true;
+}
+
+/*!
+  \return true, while a file is loaded
+  \sa load(), cancel()
+ */
+bool QwtSeriesLoader::isLoading() const
+{
+    return d_data->timerId != 0;
+}
+
+/*!
+  \brief Stop loading
+
+  The samples, that have been appended so far, remain in the curve.
+  \sa load()
+ */
+void QwtSeriesLoader::cancel()
+{
+    if ( d_data->results )
+    {
+        QMutexLocker locker( &d_data->results->mutex );
+        d_data->results->isCancelled = true;
+    }
+
+    release();
+}
+
+/*!
+  Append the parsed blocks to the curve
+  \param event Timer event
+ */
+void QwtSeriesLoader::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() != d_data->timerId )
+    {
+        QObject::timerEvent( event );
+        return;
+    }
+
+#if !QWT_USE_THREADS
+    PrivateData *d = d_data;
+
+    // parsing in the GUI thread, but not for longer 
+    // than half of the update interval
+
+    QwtSystemClock clock;
+    clock.start();
+
+    const char *text = reinterpret_cast<const char *>( d->data );
+
+    while ( d->numParsed < d->boundaries.size() - 1
+        && clock.elapsed() < 0.5 * d->updateInterval )
+    {
+        const int i = d->numParsed++;
+
+        QwtParseCommand command = d->command;
+        command.begin = text + d->boundaries[i];
+        command.end = text + d->boundaries[i + 1];
+
+        qwtParseBlock( command, d->results, i );
+    }
+#endif
+
+    publish();
+}
+
+void QwtSeriesLoader::publish()
+{
+    PrivateData *d = d_data;
+
+    const int numBlocks = d->boundaries.size() - 1;
+
+    QVector<QPointF> samples;
+
+    {
+        QMutexLocker locker( &d->results->mutex );
+
+        while ( d->numPublished < numBlocks 
+            && d->results->isDone.testBit( d->numPublished ) )
+        {
+            samples += d->results->blocks[ d->numPublished ];
+            d->results->blocks[ d->numPublished ] = QVector<QPointF>();
+
+            d->numPublished++;
+        }
+    }
+
+    if ( !samples.isEmpty() )
+    {
+        if ( d->xColumn < 0 && d->format == Csv )
+        {
+            for ( int i = 0; i < samples.size(); i++ )
+                samples[i].rx() = d->numSamples + i;
+        }
+
+        d->numSamples += samples.size();
+
+        d->curve->appendSamples( samples );
+
+        QwtPlot *plot = d->curve->plot();
+        if ( plot && !plot->autoReplot() )
+            plot->replot();
+    }
+
+    const qint64 size = d->boundaries.last();
+    Q_EMIT progress( d->boundaries[ d->numPublished ], size );
+
+    if ( d->numPublished == numBlocks )
+    {
+        release();
+        Q_EMIT finished();
+    }
+}
+
+void QwtSeriesLoader::release()
+{
+    PrivateData *d = d_data;
+
+    if ( d->timerId )
+    {
+        killTimer( d->timerId );
+        d->timerId = 0;
+    }
+
+#if QWT_USE_THREADS
+    for ( int i = 0; i < d->futures.size(); i++ )
+        d->futures[i].waitForFinished();
+
+    d->futures.clear();
+#endif
+
+    delete d->results;
+    d->results = NULL;
+
+    if ( d->data )
+    {
+        d->file.unmap( d->data );
+        d->data = NULL;
+    }
+
+    d->file.close();
+    d->boundaries.clear();
+
+    d->curve = NULL;
+}
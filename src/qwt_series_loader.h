@@ -0,0 +1,115 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SERIES_LOADER_H
+#define QWT_SERIES_LOADER_H 1
+
+#include "qwt_global.h"
+#include <qobject.h>
+
+class QwtPlotCurve;
+class QString;
+
+/*!
+  \brief Loading the samples of a curve from a file in the background
+
+  QwtSeriesLoader reads CSV files or binary files of interleaved
+  x/y values without blocking the GUI thread:
+
+  - The file is mapped into memory and split into blocks
+    of about BlockSize bytes at line boundaries.
+  - The blocks are parsed in parallel by worker threads
+    ( QtConcurrent ), each of them into a single array of samples.
+  - In intervals of updateInterval() the parsed blocks are appended 
+    in the order of the file to the curve ( QwtPlotCurve::appendSamples() )
+    and the plot is replotted. So the curve shows the data, that has
+    been loaded so far.
+
+  Appending happens in the GUI thread only, so that the curve 
+  can be painted and navigated while loading.
+
+  In CSV files lines, where the x or y value can't be parsed,
+  are skipped ( f.e. a header line ).
+
+  \code
+QwtSeriesLoader *loader = new QwtSeriesLoader( this );
+loader->setColumns( 0, 3 );
+loader->load( "capture.csv", curve );
+  \endcode
+
+  \warning The curve must not be deleted while loading. 
+           Call cancel() before.
+ */
+class QWT_EXPORT QwtSeriesLoader: public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Number of bytes, that are parsed together
+    enum { BlockSize = 1024 * 1024 };
+
+    //! Format of the file
+    enum Format
+    {
+        //! Text file with lines of values, separated by separator()
+        Csv,
+
+        //! Interleaved x/y values as doubles in host byte order
+        BinaryDouble,
+
+        //! Interleaved x/y values as floats in host byte order
+        BinaryFloat
+    };
+
+    explicit QwtSeriesLoader( QObject *parent = NULL );
+    virtual ~QwtSeriesLoader();
+
+    void setFormat( Format );
+    Format format() const;
+
+    void setColumns( int xColumn, int yColumn );
+    int xColumn() const;
+    int yColumn() const;
+
+    void setSeparator( char );
+    char separator() const;
+
+    void setUpdateInterval( int ms );
+    int updateInterval() const;
+
+    bool load( const QString &fileName, QwtPlotCurve * );
+    bool isLoading() const;
+
+public Q_SLOTS:
+    void cancel();
+
+Q_SIGNALS:
+    /*!
+      A signal, that is emitted, when samples have been appended 
+
+      \param bytesDone Number of bytes, that have been loaded
+      \param bytesTotal Size of the file
+     */
+    void progress( qint64 bytesDone, qint64 bytesTotal );
+
+    //! A signal, that is emitted, when all samples have been loaded
+    void finished();
+
+protected:
+    virtual void timerEvent( QTimerEvent * );
+
+private:
+    void publish();
+    void release();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -0,0 +1,333 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_shared_column_data.h"
+#include "qwt_scale_map.h"
+#include <qatomic.h>
+#include <qmutex.h>
+#include <qbitarray.h>
+#include <string.h>
+
+class QwtSharedXColumn::PrivateData
+{
+public:
+    PrivateData( const QVector<double> &x ):
+        ref( 1 ),
+        values( x ),
+        hasMappedValues( false )
+    {
+        for ( int i = 0; i < values.size(); i++ )
+        {
+            const double value = values[i];
+            if ( qIsNaN( value ) )
+                continue;
+
+            if ( interval.isValid() )
+                interval |= value;
+            else
+                interval.setInterval( value, value );
+        }
+    }
+
+    bool matches( const QwtScaleMap &map ) const
+    {
+        return hasMappedValues && map == xMap;
+    }
+
+    QAtomicInt ref;
+
+    const QVector<double> values;
+    QwtInterval interval;
+
+    QMutex mutex;
+
+    // the map of the mapped values
+    QwtScaleMap xMap;
+
+    bool hasMappedValues;
+    QVector<double> mappedValues;
+    QBitArray isMapped;
+};
+
+//! Constructor of an empty column
+QwtSharedXColumn::QwtSharedXColumn()
+{
+    d_data = new PrivateData( QVector<double>() );
+}
+
+/*!
+  Constructor
+
+  \param values x values
+ */
+QwtSharedXColumn::QwtSharedXColumn( const QVector<double> &values )
+{
+    d_data = new PrivateData( values );
+}
+
+/*!
+  Copy constructor
+
+  The copy refers to the same values.
+  \param other Other column
+ */
+QwtSharedXColumn::QwtSharedXColumn( const QwtSharedXColumn &other ):
+    d_data( other.d_data )
+{
+    d_data->ref.ref();
+}
+
+//! Destructor
+QwtSharedXColumn::~QwtSharedXColumn()
+{
+    if ( !d_data->ref.deref() )
+        delete d_data;
+}
+
+/*!
+  Assignment operator
+
+  \param other Other column
+  \return Reference to this column, that refers to the values of other
+ */
+QwtSharedXColumn &QwtSharedXColumn::operator=( const QwtSharedXColumn &other )
+{
+    other.d_data->ref.ref();
+
+    if ( !d_data->ref.deref() )
+        delete d_data;
+
+    d_data = other.d_data;
+    return *this;
+}
+
+//! \return Number of values
+int QwtSharedXColumn::size() const
+{
+    return d_data->values.size();
+}
+
+//! \return Values
+const QVector<double> &QwtSharedXColumn::values() const
+{
+    return d_data->values;
+}
+
+/*!
+  \return Interval of all values, that are not NaN
+ */
+QwtInterval QwtSharedXColumn::interval() const
+{
+    return d_data->interval;
+}
+
+/*!
+  \brief Map a range of values into paint device coordinates
+
+  The mapped values are calculated once for all calls with
+  the same scale map - see QwtScaleMap::operator==().
+
+  \param xMap Maps x-values into paint device coordinates
+  \param from Index of the first value
+  \param count Number of values
+  \param values Buffer for at least count values
+ */
+void QwtSharedXColumn::mapValues( const QwtScaleMap &xMap,
+    int from, int count, double *values ) const
+{
+    PrivateData *d = d_data;
+
+    if ( count <= 0 )
+        return;
+
+    QMutexLocker locker( &d->mutex );
+
+    if ( !d->matches( xMap ) )
+    {
+        const int numBlocks = ( d->values.size() + BlockSize - 1 ) / BlockSize;
+
+        d->xMap = xMap;
+
+        d->mappedValues.resize( d->values.size() );
+        d->isMapped = QBitArray( numBlocks );
+
+        d->hasMappedValues = true;
+    }
+
+    const int to = from + count - 1;
+
+    for ( int block = from / BlockSize; block <= to / BlockSize; block++ )
+    {
+        if ( !d->isMapped.testBit( block ) )
+        {
+            const int index = block * BlockSize;
+            const int n = qMin( static_cast<int>( BlockSize ),
+                d->values.size() - index );
+
+            xMap.transform( d->values.constData() + index,
+                d->mappedValues.data() + index, n );
+
+            d->isMapped.setBit( block );
+        }
+    }
+
+    ::memcpy( values, d->mappedValues.constData() + from,
+        count * sizeof( double ) );
+}
+
+/*!
+  Constructor
+
+  \param x Shared x values
+  \param y y values
+ */
+QwtSharedXColumnData::QwtSharedXColumnData(
+        const QwtSharedXColumn &x, const QVector<double> &y ):
+    d_x( x ),
+    d_y( y )
+{
+}
+
+/*!
+  \brief Calculate the bounding rectangle
+
+  The interval of the x values is taken from the shared column,
+  only the y values have to be iterated.
+
+  \return Bounding rectangle
+*/
+QRectF QwtSharedXColumnData::boundingRect() const
+{
+    if ( d_boundingRect.width() < 0 )
+    {
+        if ( d_y.size() < d_x.size() )
+        {
+            d_boundingRect = qwtBoundingRect( *this );
+        }
+        else
+        {
+            const QwtInterval xInterval = d_x.interval();
+
+            double minY = 0.0;
+            double maxY = -1.0;
+
+            for ( int i = 0; i < d_x.size(); i++ )
+            {
+                const double y = d_y[i];
+                if ( qIsNaN( y ) )
+                    continue;
+
+                if ( minY > maxY )
+                {
+                    minY = maxY = y;
+                }
+                else
+                {
+                    minY = qMin( minY, y );
+                    maxY = qMax( maxY, y );
+                }
+            }
+
+            if ( xInterval.isValid() && minY <= maxY )
+            {
+                d_boundingRect.setCoords( xInterval.minValue(), minY,
+                    xInterval.maxValue(), maxY );
+            }
+            else
+            {
+                d_boundingRect = QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+            }
+        }
+    }
+
+    return d_boundingRect;
+}
+
+//! \return Size of the data set
+size_t QwtSharedXColumnData::size() const
+{
+    return qMin( d_x.size(), d_y.size() );
+}
+
+/*!
+  Return the sample at position i
+
+  \param index Index
+  \return Sample at position i
+*/
+QPointF QwtSharedXColumnData::sample( size_t index ) const
+{
+    return QPointF( d_x.values()[int( index )], d_y[int( index )] );
+}
+
+/*!
+  Copy a block of samples into a buffer
+
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+*/
+void QwtSharedXColumnData::copySamples(
+    size_t from, size_t count, QPointF *samples ) const
+{
+    const double *x = d_x.values().constData() + from;
+    const double *y = d_y.constData() + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        samples[i] = QPointF( x[i], y[i] );
+}
+
+/*!
+  \brief Copy a block of samples, mapped into paint device coordinates
+
+  The mapped x values are taken from the cache of the shared column.
+
+  \param xMap Maps x-values into paint device coordinates
+  \param yMap Maps y-values into paint device coordinates
+  \param from Index of the first sample
+  \param count Number of samples to copy
+  \param samples Buffer with space for at least count samples
+
+  \return true
+*/
+bool QwtSharedXColumnData::copyMappedSamples(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    size_t from, size_t count, QPointF *samples ) const
+{
+    const int blockSize = 256;
+    double values[ blockSize ];
+
+    for ( int i = 0; i < static_cast<int>( count ); i += blockSize )
+    {
+        const int index = static_cast<int>( from ) + i;
+        const int n = qMin( blockSize, static_cast<int>( count ) - i );
+
+        d_x.mapValues( xMap, index, n, values );
+        for ( int j = 0; j < n; j++ )
+            samples[i + j].rx() = values[j];
+
+        yMap.transform( d_y.constData() + index, values, n );
+        for ( int j = 0; j < n; j++ )
+            samples[i + j].ry() = values[j];
+    }
+
+    return true;
+}
+
+//! \return Shared x values
+const QwtSharedXColumn &QwtSharedXColumnData::xColumn() const
+{
+    return d_x;
+}
+
+//! \return y values
+const QVector<double> &QwtSharedXColumnData::yData() const
+{
+    return d_y;
+}
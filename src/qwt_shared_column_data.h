@@ -0,0 +1,115 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SHARED_COLUMN_DATA_H
+#define QWT_SHARED_COLUMN_DATA_H 1
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+#include "qwt_interval.h"
+
+class QwtScaleMap;
+
+/*!
+  \brief An immutable column of x values, that is shared between series
+
+  In multichannel views all channels often have the same timebase.
+  QwtSharedXColumn stores the x values once for all of them.
+  It is implicitly shared: copies of a column are cheap and refer 
+  to the same values.
+
+  Beside the values the column stores:
+
+  - the interval of the values, so that the bounding rectangles of 
+    all series sharing the column don't need to iterate over them.
+  - the values mapped into paint device coordinates. They are
+    calculated on demand in blocks of BlockSize values
+    for the first series, that is painted with a scale map, and 
+    reused by all following series painted with the same map.
+
+  The cache holds the values for one scale map only. When the
+  column is displayed on different plots with different scales
+  the values are recalculated, whenever the map changes.
+
+  \sa QwtSharedXColumnData
+ */
+class QWT_EXPORT QwtSharedXColumn
+{
+public:
+    //! Number of values, that are mapped at once
+    enum { BlockSize = 1024 };
+
+    QwtSharedXColumn();
+    explicit QwtSharedXColumn( const QVector<double> &values );
+
+    QwtSharedXColumn( const QwtSharedXColumn & );
+    ~QwtSharedXColumn();
+
+    QwtSharedXColumn &operator=( const QwtSharedXColumn & );
+
+    int size() const;
+    const QVector<double> &values() const;
+
+    QwtInterval interval() const;
+
+    void mapValues( const QwtScaleMap &xMap,
+        int from, int count, double *values ) const;
+
+private:
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+/*!
+  \brief Series of points with a shared column of x values
+
+  QwtSharedXColumnData combines a QwtSharedXColumn with an individual
+  array of y values. All curves of a multichannel view can reference 
+  the same column of x values, so that the memory, the calculation 
+  of the bounding rectangles and the mapping of the x values is needed
+  only once for all of them.
+
+  \code
+QwtSharedXColumn timeBase( times );
+
+for ( int i = 0; i < numChannels; i++ )
+{
+    QwtPlotCurve *curve = new QwtPlotCurve();
+    curve->setData( new QwtSharedXColumnData( timeBase, channels[i] ) );
+    curve->attach( plot );
+}
+  \endcode
+ */
+class QWT_EXPORT QwtSharedXColumnData: public QwtSeriesData<QPointF>
+{
+public:
+    QwtSharedXColumnData( const QwtSharedXColumn &x,
+        const QVector<double> &y );
+
+    virtual QRectF boundingRect() const;
+
+    virtual size_t size() const;
+    virtual QPointF sample( size_t i ) const;
+
+    virtual void copySamples( size_t from,
+        size_t count, QPointF *samples ) const;
+
+    virtual bool copyMappedSamples( 
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        size_t from, size_t count, QPointF *samples ) const;
+
+    const QwtSharedXColumn &xColumn() const;
+    const QVector<double> &yData() const;
+
+private:
+    QwtSharedXColumn d_x;
+    QVector<double> d_y;
+};
+
+#endif
@@ -0,0 +1,439 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_spatial_index.h"
+#include "qwt_scale_map.h"
+#include "qwt_math.h"
+#include <qnumeric.h>
+#include <algorithm>
+
+class QwtIndexNode
+{
+public:
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+};
+
+class QwtIndexedSample
+{
+public:
+    QPointF pos;
+    int index;
+};
+
+class QwtCompareSamples
+{
+public:
+    QwtCompareSamples( bool compareX ):
+        d_compareX( compareX )
+    {
+    }
+
+    inline bool operator()( const QwtIndexedSample &s1,
+        const QwtIndexedSample &s2 ) const
+    {
+        if ( d_compareX )
+            return s1.pos.x() < s2.pos.x();
+
+        return s1.pos.y() < s2.pos.y();
+    }
+
+private:
+    const bool d_compareX;
+};
+
+class QwtSpatialIndex::PrivateData
+{
+public:
+    PrivateData():
+        numSamples( 0 ),
+        depth( 0 )
+    {
+    }
+
+    void buildNode( QwtIndexedSample *samples, 
+        int node, int from, int to, int level );
+
+    size_t numSamples;
+
+    // nodes of a complete binary tree: the children of node n
+    // are 2 * n + 1 and 2 * n + 2. The samples of a node are
+    // the range [from, to[ of indices, where the split position 
+    // is always in the middle of the range.
+
+    int depth;
+    QVector<int> indices;
+    QVector<QwtIndexNode> nodes;
+};
+
+void QwtSpatialIndex::PrivateData::buildNode( QwtIndexedSample *samples,
+    int node, int from, int to, int level )
+{
+    QwtIndexNode &n = nodes[node];
+
+    if ( level == depth )
+    {
+        n.x1 = n.y1 = qInf();
+        n.x2 = n.y2 = -qInf();
+
+        for ( int i = from; i < to; i++ )
+        {
+            const QPointF &pos = samples[i].pos;
+
+            n.x1 = qMin( n.x1, pos.x() );
+            n.x2 = qMax( n.x2, pos.x() );
+            n.y1 = qMin( n.y1, pos.y() );
+            n.y2 = qMax( n.y2, pos.y() );
+        }
+
+        return;
+    }
+
+    const int mid = from + ( to - from ) / 2;
+
+    std::nth_element( samples + from, samples + mid, 
+        samples + to, QwtCompareSamples( level % 2 == 0 ) );
+
+    buildNode( samples, 2 * node + 1, from, mid, level + 1 );
+    buildNode( samples, 2 * node + 2, mid, to, level + 1 );
+
+    const QwtIndexNode &n1 = nodes[2 * node + 1];
+    const QwtIndexNode &n2 = nodes[2 * node + 2];
+
+    n.x1 = qMin( n1.x1, n2.x1 );
+    n.x2 = qMax( n1.x2, n2.x2 );
+    n.y1 = qMin( n1.y1, n2.y1 );
+    n.y2 = qMax( n1.y2, n2.y2 );
+}
+
+class QwtClosestSampleSearch
+{
+public:
+    QwtClosestSampleSearch( const QwtSeriesData<QPointF> &series,
+            const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+            const QVector<int> &indices, const QVector<QwtIndexNode> &nodes,
+            int depth, const QPointF &pos ):
+        index( -1 ),
+        distance( 1.0e10 ),
+        d_series( series ),
+        d_xMap( xMap ),
+        d_yMap( yMap ),
+        d_indices( indices ),
+        d_nodes( nodes ),
+        d_depth( depth ),
+        d_pos( pos )
+    {
+    }
+
+    void search( int node, int from, int to, int level )
+    {
+        if ( level == d_depth )
+        {
+            for ( int i = from; i < to; i++ )
+            {
+                const int idx = d_indices[i];
+                const QPointF sample = d_series.sample( idx );
+
+                const double dx = d_xMap.transform( sample.x() ) - d_pos.x();
+                const double dy = d_yMap.transform( sample.y() ) - d_pos.y();
+
+                const double d = qwtSqr( dx ) + qwtSqr( dy );
+
+                // the lowest index wins, like when iterating over the series
+                if ( d < distance || ( d == distance && idx < index ) )
+                {
+                    index = idx;
+                    distance = d;
+                }
+            }
+
+            return;
+        }
+
+        const int mid = from + ( to - from ) / 2;
+
+        const int node1 = 2 * node + 1;
+        const int node2 = 2 * node + 2;
+
+        const double d1 = lowerBound( d_nodes[node1] );
+        const double d2 = lowerBound( d_nodes[node2] );
+
+        if ( d1 <= d2 )
+        {
+            if ( d1 <= distance )
+                search( node1, from, mid, level + 1 );
+
+            if ( d2 <= distance )
+                search( node2, mid, to, level + 1 );
+        }
+        else
+        {
+            if ( d2 <= distance )
+                search( node2, mid, to, level + 1 );
+
+            if ( d1 <= distance )
+                search( node1, from, mid, level + 1 );
+        }
+    }
+
+    double lowerBound( const QwtIndexNode &node ) const
+    {
+        if ( node.x1 > node.x2 )
+            return qInf(); // empty
+
+        double x1 = d_xMap.transform( node.x1 );
+        double x2 = d_xMap.transform( node.x2 );
+        if ( x1 > x2 )
+            qSwap( x1, x2 );
+
+        double y1 = d_yMap.transform( node.y1 );
+        double y2 = d_yMap.transform( node.y2 );
+        if ( y1 > y2 )
+            qSwap( y1, y2 );
+
+        double dx = 0.0;
+        if ( d_pos.x() < x1 )
+            dx = x1 - d_pos.x();
+        else if ( d_pos.x() > x2 )
+            dx = d_pos.x() - x2;
+
+        double dy = 0.0;
+        if ( d_pos.y() < y1 )
+            dy = y1 - d_pos.y();
+        else if ( d_pos.y() > y2 )
+            dy = d_pos.y() - y2;
+
+        return qwtSqr( dx ) + qwtSqr( dy );
+    }
+
+    int index;
+    double distance;
+
+private:
+    const QwtSeriesData<QPointF> &d_series;
+    const QwtScaleMap &d_xMap;
+    const QwtScaleMap &d_yMap;
+    const QVector<int> &d_indices;
+    const QVector<QwtIndexNode> &d_nodes;
+    const int d_depth;
+    const QPointF d_pos;
+};
+
+class QwtRectSearch
+{
+public:
+    QwtRectSearch( const QwtSeriesData<QPointF> &series,
+            const QVector<int> &indices, const QVector<QwtIndexNode> &nodes,
+            int depth, const QRectF &rect ):
+        d_series( series ),
+        d_indices( indices ),
+        d_nodes( nodes ),
+        d_depth( depth ),
+        d_x1( rect.left() ),
+        d_x2( rect.right() ),
+        d_y1( rect.top() ),
+        d_y2( rect.bottom() )
+    {
+    }
+
+    void search( int node, int from, int to, int level )
+    {
+        const QwtIndexNode &n = d_nodes[node];
+
+        if ( n.x1 > d_x2 || n.x2 < d_x1 || n.y1 > d_y2 || n.y2 < d_y1 )
+            return;
+
+        if ( n.x1 >= d_x1 && n.x2 <= d_x2 && n.y1 >= d_y1 && n.y2 <= d_y2 )
+        {
+            for ( int i = from; i < to; i++ )
+                samples += d_indices[i];
+
+            return;
+        }
+
+        if ( level == d_depth )
+        {
+            for ( int i = from; i < to; i++ )
+            {
+                const QPointF sample = d_series.sample( d_indices[i] );
+                if ( sample.x() >= d_x1 && sample.x() <= d_x2
+                    && sample.y() >= d_y1 && sample.y() <= d_y2 )
+                {
+                    samples += d_indices[i];
+                }
+            }
+
+            return;
+        }
+
+        const int mid = from + ( to - from ) / 2;
+
+        search( 2 * node + 1, from, mid, level + 1 );
+        search( 2 * node + 2, mid, to, level + 1 );
+    }
+
+    QVector<int> samples;
+
+private:
+    const QwtSeriesData<QPointF> &d_series;
+    const QVector<int> &d_indices;
+    const QVector<QwtIndexNode> &d_nodes;
+    const int d_depth;
+    const double d_x1;
+    const double d_x2;
+    const double d_y1;
+    const double d_y2;
+};
+
+/*!
+  \brief Constructor
+
+  The index is empty until build() has been called.
+ */
+QwtSpatialIndex::QwtSpatialIndex()
+{
+    d_data = new PrivateData();
+}
+
+//! Destructor
+QwtSpatialIndex::~QwtSpatialIndex()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Build the index for a series
+
+  All samples of the series are read once. Building the index
+  needs O(n * log(n)) operations and temporary memory for a copy
+  of the samples.
+
+  \param series Series
+  \sa reset()
+ */
+void QwtSpatialIndex::build( const QwtSeriesData<QPointF> &series )
+{
+    reset();
+
+    const size_t numSamples = series.size();
+    d_data->numSamples = numSamples;
+
+    if ( numSamples == 0 )
+        return;
+
+    QVector<QwtIndexedSample> samples;
+    samples.reserve( static_cast<int>( numSamples ) );
+
+    QwtSeriesReader<QPointF> reader( series, 0, numSamples - 1 );
+    for ( int i = 0; reader.hasNext(); i++ )
+    {
+        const QPointF &pos = reader.next();
+
+        if ( qIsFinite( pos.x() ) && qIsFinite( pos.y() ) )
+        {
+            QwtIndexedSample sample;
+            sample.pos = pos;
+            sample.index = i;
+
+            samples += sample;
+        }
+    }
+
+    const int count = samples.size();
+    if ( count == 0 )
+        return;
+
+    int depth = 0;
+    while ( ( ( count - 1 ) >> depth ) + 1 > LeafSize )
+        depth++;
+
+    d_data->depth = depth;
+    d_data->nodes.resize( ( 2 << depth ) - 1 );
+    d_data->buildNode( samples.data(), 0, 0, count, 0 );
+
+    d_data->indices.resize( count );
+    for ( int i = 0; i < count; i++ )
+        d_data->indices[i] = samples[i].index;
+}
+
+/*!
+  \brief Clear the index
+  \sa build()
+ */
+void QwtSpatialIndex::reset()
+{
+    d_data->numSamples = 0;
+    d_data->depth = 0;
+    d_data->indices.clear();
+    d_data->nodes.clear();
+}
+
+/*!
+  \return Number of samples of the series, the index has been built for
+  \sa build()
+ */
+size_t QwtSpatialIndex::size() const
+{
+    return d_data->numSamples;
+}
+
+/*!
+  \brief Find the sample, that is closest to a position in paint device coordinates
+
+  \param series Series, the index has been built for
+  \param xMap Maps x-values into pixel coordinates
+  \param yMap Maps y-values into pixel coordinates
+  \param pos Position in paint device coordinates
+  \param dist If dist != NULL, the distance between pos and the
+              closest sample is returned
+
+  \return Index of the closest sample, or -1 if none can be found
+  \sa QwtPlotCurve::closestPoint()
+ */
+int QwtSpatialIndex::closestSample( const QwtSeriesData<QPointF> &series,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QPointF &pos, double *dist ) const
+{
+    QwtClosestSampleSearch searcher( series, xMap, yMap,
+        d_data->indices, d_data->nodes, d_data->depth, pos );
+
+    if ( series.size() == d_data->numSamples && !d_data->nodes.isEmpty() )
+        searcher.search( 0, 0, d_data->indices.size(), 0 );
+
+    if ( dist )
+        *dist = qSqrt( searcher.distance );
+
+    return searcher.index;
+}
+
+/*!
+  \brief Find all samples inside of a rectangle
+
+  \param series Series, the index has been built for
+  \param rect Rectangle in data coordinates. Samples on the border
+              are included.
+
+  \return Indices of the samples inside of the rectangle in increasing order
+ */
+QVector<int> QwtSpatialIndex::samplesInRect(
+    const QwtSeriesData<QPointF> &series, const QRectF &rect ) const
+{
+    QwtRectSearch searcher( series, d_data->indices, 
+        d_data->nodes, d_data->depth, rect.normalized() );
+
+    if ( series.size() == d_data->numSamples && !d_data->nodes.isEmpty() )
+    {
+        searcher.search( 0, 0, d_data->indices.size(), 0 );
+        std::sort( searcher.samples.begin(), searcher.samples.end() );
+    }
+
+    return searcher.samples;
+}
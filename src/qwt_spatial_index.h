@@ -0,0 +1,69 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SPATIAL_INDEX_H
+#define QWT_SPATIAL_INDEX_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtScaleMap;
+
+/*!
+  \brief A spatial index for the samples of a series
+
+  QwtSpatialIndex organizes the samples of a series in a balanced
+  tree ( "k-d tree" ), where each node stores the bounding
+  rectangle of its samples. The samples of a node are split
+  at the median of their x or y coordinates - alternating from level
+  to level - until a leaf contains not more than LeafSize samples.
+
+  The tree is built in data coordinates, but as the scale maps are
+  monotonic for each axis the bounding rectangles can be translated
+  into paint device coordinates for each query. So closestSample()
+  finds the nearest sample in pixels - like QwtPlotCurve::closestPoint() - 
+  without iterating over all samples.
+
+  Samples with non finite coordinates are not indexed.
+
+  The index stores an integer for each sample and a rectangle for
+  each node, the series needs to be passed to all methods, that have to
+  read values.
+
+  \sa QwtPlotCurve::setSpatialIndexEnabled()
+ */
+class QWT_EXPORT QwtSpatialIndex
+{
+public:
+    //! Maximum number of samples of a leaf
+    enum { LeafSize = 16 };
+
+    QwtSpatialIndex();
+    ~QwtSpatialIndex();
+
+    void build( const QwtSeriesData<QPointF> &series );
+    void reset();
+
+    size_t size() const;
+
+    int closestSample( const QwtSeriesData<QPointF> &series,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QPointF &pos, double *dist = NULL ) const;
+
+    QVector<int> samplesInRect( const QwtSeriesData<QPointF> &series,
+        const QRectF &rect ) const;
+
+private:
+    Q_DISABLE_COPY(QwtSpatialIndex)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
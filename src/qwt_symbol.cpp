@@ -15,11 +15,19 @@
 #include <qpainterpath.h>
 #include <qpixmap.h>
 #include <qpaintengine.h>
+#include <qimage.h>
 #include <qmath.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
 #ifndef QWT_NO_SVG
 #include <qsvgrenderer.h>
 #endif
 
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
 namespace QwtTriangle
 {
     enum Type
@@ -767,6 +775,241 @@ static inline void qwtDrawHexagonSymbols( QPainter *painter,
     }
 }
 
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtSpriteCommand
+{
+public:
+    const QImage *sprites;
+    int phases;
+
+    // position of the symbol inside of a sprite
+    QPoint offset;
+
+    // translation from painter to image coordinates
+    QPointF translation;
+
+    QRect clipRect;
+    QImage *image;
+};
+
+static inline int qwtFloorDiv( int value, int divisor )
+{
+    return ( value >= 0 ) ? ( value / divisor )
+        : -( ( divisor - 1 - value ) / divisor );
+}
+
+/*
+  Source over composition of a premultiplied pixel. The
+  alpha of a RGB32 destination stays at 255.
+ */
+static inline QRgb qwtSourceOver( QRgb dst, QRgb src )
+{
+    const uint a = 255 - qAlpha( src );
+
+    uint rb = ( dst & 0xff00ff ) * a;
+    rb = ( ( rb + ( ( rb >> 8 ) & 0xff00ff ) + 0x800080 ) >> 8 ) & 0xff00ff;
+
+    uint ag = ( ( dst >> 8 ) & 0xff00ff ) * a;
+    ag = ( ag + ( ( ag >> 8 ) & 0xff00ff ) + 0x800080 ) & 0xff00ff00;
+
+    return src + ( rb | ag );
+}
+
+/*
+  Composite the sprites of all points into the rows [y1, y2] of
+  the image. As each thread works on a band of rows of its own, 
+  but iterates over all points, overlapping symbols are composed 
+  in the same order as with QPainter.
+ */
+static void qwtBlitSprites( const QwtSpriteCommand command,
+    const QPointF *points, int numPoints, int y1, int y2 )
+{
+    const int phases = command.phases;
+    const int w = command.sprites[0].width();
+    const int h = command.sprites[0].height();
+
+    const QRect &clipRect = command.clipRect;
+
+    // candidates for being visible, avoiding integer overflows
+    const double xMin = clipRect.left() - command.offset.x() - w - 1.0;
+    const double xMax = clipRect.right() - command.offset.x() + 1.0;
+    const double yMin = y1 - command.offset.y() - h - 1.0;
+    const double yMax = y2 - command.offset.y() + 1.0;
+
+    QImage *image = command.image;
+    uchar *bits = image->bits();
+    const int bytesPerLine = image->bytesPerLine();
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const double x = points[i].x() + command.translation.x();
+        const double y = points[i].y() + command.translation.y();
+
+        if ( !( x > xMin && x < xMax && y > yMin && y < yMax ) )
+            continue;
+
+        int left, top, index;
+        if ( phases == 1 )
+        {
+            left = qRound( x );
+            top = qRound( y );
+            index = 0;
+        }
+        else
+        {
+            // the sprite with the nearest sub pixel offset 
+
+            const int px = qFloor( x * phases + 0.5 );
+            const int py = qFloor( y * phases + 0.5 );
+
+            left = qwtFloorDiv( px, phases );
+            top = qwtFloorDiv( py, phases );
+            index = ( py - top * phases ) * phases + ( px - left * phases );
+        }
+
+        left += command.offset.x();
+        top += command.offset.y();
+
+        const int x1 = qMax( left, clipRect.left() );
+        const int x2 = qMin( left + w - 1, clipRect.right() );
+        const int r1 = qMax( top, y1 );
+        const int r2 = qMin( top + h - 1, y2 );
+
+        if ( x1 > x2 || r1 > r2 )
+            continue;
+
+        const QImage &sprite = command.sprites[index];
+
+        for ( int row = r1; row <= r2; row++ )
+        {
+            const QRgb *src = reinterpret_cast<const QRgb *>( 
+                sprite.constScanLine( row - top ) ) + ( x1 - left );
+
+            QRgb *dst = reinterpret_cast<QRgb *>( 
+                bits + row * bytesPerLine ) + x1;
+
+            for ( int col = x1; col <= x2; col++, src++, dst++ )
+            {
+                const QRgb s = *src;
+                if ( s == 0 )
+                    continue;
+
+                if ( qAlpha( s ) == 255 )
+                    *dst = s;
+                else
+                    *dst = qwtSourceOver( *dst, s );
+            }
+        }
+    }
+}
+
+static void qwtBlitSymbols( const QwtSpriteCommand &command,
+    const QPointF *points, int numPoints, uint renderThreadCount )
+{
+    const QRect &clipRect = command.clipRect;
+
+#if QWT_USE_THREADS
+    const int minRows = 16;
+
+    if ( renderThreadCount == 0 )
+        renderThreadCount = QThread::idealThreadCount();
+
+    int numThreads = qMin( int( renderThreadCount ), 
+        clipRect.height() / minRows );
+
+    if ( qint64( numPoints ) * command.sprites[0].width() 
+        * command.sprites[0].height() < 100000 )
+    {
+        // not worth the overhead of threads
+        numThreads = 1;
+    }
+
+    if ( numThreads > 1 )
+    {
+        const int numRows = clipRect.height() / numThreads;
+
+        QList< QFuture<void> > futures;
+        for ( int i = 0; i < numThreads; i++ )
+        {
+            const int y1 = clipRect.top() + i * numRows;
+            if ( i == numThreads - 1 )
+            {
+                qwtBlitSprites( command, points, numPoints, 
+                    y1, clipRect.bottom() );
+            }
+            else
+            {
+                futures += QtConcurrent::run( &qwtBlitSprites, command,
+                    points, numPoints, y1, y1 + numRows - 1 );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        return;
+    }
+#else
+    Q_UNUSED( renderThreadCount )
+#endif
+
+    qwtBlitSprites( command, points, numPoints, 
+        clipRect.top(), clipRect.bottom() );
+}
+
+/*
+  Return the image, when the painter is drawing to a QImage, where
+  symbols can be composed without QPainter. clipRect and translation 
+  are returned in image coordinates.
+ */
+static QImage *qwtSpriteImage( QPainter *painter, 
+    QRect &clipRect, QPointF &translation )
+{
+    QPaintDevice *device = painter->device();
+    if ( device == NULL || device->devType() != QInternal::Image )
+        return NULL;
+
+    if ( painter->paintEngine()->type() != QPaintEngine::Raster )
+        return NULL;
+
+    QImage *image = static_cast<QImage *>( device );
+    if ( image->format() != QImage::Format_ARGB32_Premultiplied &&
+        image->format() != QImage::Format_RGB32 )
+    {
+        return NULL;
+    }
+
+    if ( painter->compositionMode() != QPainter::CompositionMode_SourceOver
+        || painter->opacity() < 1.0 )
+    {
+        return NULL;
+    }
+
+    if ( QwtPainter::devicePixelRatio( device ) != 1.0 )
+        return NULL;
+
+    const QTransform transform = painter->deviceTransform();
+    if ( transform.type() > QTransform::TxTranslate )
+        return NULL;
+
+    translation = QPointF( transform.dx(), transform.dy() );
+
+    clipRect = image->rect();
+    if ( painter->hasClipping() )
+    {
+        const QRegion clipRegion = painter->clipRegion();
+        if ( clipRegion.rectCount() > 1 )
+            return NULL;
+
+        // clipRegion() is in logical coordinates
+        clipRect &= clipRegion.boundingRect().translated( 
+            qRound( translation.x() ), qRound( translation.y() ) );
+    }
+
+    return image;
+}
+
 class QwtSymbol::PrivateData
 {
 public:
@@ -830,6 +1073,10 @@ public:
         QwtSymbol::CachePolicy policy;
         QPixmap pixmap;
 
+        // premultiplied images for composing the symbols
+        // without QPainter, one for each sub pixel offset
+        QVector<QImage> sprites;
+
     } cache;
 };
 
@@ -1299,16 +1546,84 @@ bool QwtSymbol::isPinPointEnabled() const
   one by one, as a couple of layout calculations and setting of pen/brush
   can be done once for the complete array.
 
+  When painting to a QImage with the raster paint engine and the
+  cache policy is not NoCache, the symbol is rendered once - for 
+  4x4 sub pixel offsets, when the painter is not aligning - 
+  and the symbols are composed directly into the image, what
+  is by magnitudes faster than drawing pixmaps with QPainter.
+
   \param painter Painter
   \param points Array of points
   \param numPoints Number of points
+  \param numThreads Number of threads for composing the symbols 
+                    into an image, 0 means the system specific 
+                    ideal thread count
+
+  \sa CachePolicy, QwtPainter::roundingAlignment(),
+      QwtPlotItem::setRenderThreadCount()
 */
 void QwtSymbol::drawSymbols( QPainter *painter,
-    const QPointF *points, int numPoints ) const
+    const QPointF *points, int numPoints, uint numThreads ) const
 {
     if ( numPoints <= 0 )
         return;
 
+    if ( d_data->cache.policy != QwtSymbol::NoCache )
+    {
+        QRect clipRect;
+        QPointF translation;
+
+        QImage *image = qwtSpriteImage( painter, clipRect, translation );
+
+        const QRect br = boundingRect();
+        if ( image && br.isValid() )
+        {
+            if ( clipRect.isEmpty() )
+                return;
+
+            // without rounding we need sprites for 4x4 sub pixel offsets
+            const int phases = 
+                QwtPainter::roundingAlignment( painter ) ? 1 : 4;
+
+            QVector<QImage> &sprites = d_data->cache.sprites;
+            if ( sprites.size() != phases * phases )
+            {
+                sprites.clear();
+
+                const QSize size = ( phases == 1 ) ? br.size() 
+                    : QSize( br.width() + 1, br.height() + 1 );
+
+                for ( int i = 0; i < phases * phases; i++ )
+                {
+                    QImage sprite( size, QImage::Format_ARGB32_Premultiplied );
+                    sprite.fill( 0 );
+
+                    QPainter p( &sprite );
+                    p.setRenderHints( painter->renderHints() );
+                    p.translate( -br.left(), -br.top() );
+
+                    const QPointF pos( double( i % phases ) / phases, 
+                        double( i / phases ) / phases );
+                    renderSymbols( &p, &pos, 1 );
+                    p.end();
+
+                    sprites += sprite;
+                }
+            }
+
+            QwtSpriteCommand command;
+            command.sprites = sprites.constData();
+            command.phases = phases;
+            command.offset = br.topLeft();
+            command.translation = translation;
+            command.clipRect = clipRect;
+            command.image = image;
+
+            qwtBlitSymbols( command, points, numPoints, numThreads );
+            return;
+        }
+    }
+
     bool useCache = false;
 
     // Don't use the pixmap, when the paint device
@@ -1776,6 +2091,8 @@ void QwtSymbol::invalidateCache()
 {
     if ( !d_data->cache.pixmap.isNull() )
         d_data->cache.pixmap = QPixmap();
+
+    d_data->cache.sprites.clear();
 }
 
 /*!
@@ -212,7 +212,7 @@ public:
     void drawSymbol( QPainter *, const QPointF & ) const;
     void drawSymbols( QPainter *, const QPolygonF & ) const;
     void drawSymbols( QPainter *,
-        const QPointF *, int numPoints ) const;
+        const QPointF *, int numPoints, uint numThreads = 1 ) const;
 
     virtual QRect boundingRect() const;
     void invalidateCache();
@@ -9,6 +9,7 @@
 
 #include "qwt_transform.h"
 #include "qwt_math.h"
+#include <string.h>
 
 #if QT_VERSION < 0x040601
 #define qExp(x) ::exp(x)
@@ -30,6 +31,37 @@ QwtTransform::~QwtTransform()
 {
 }
 
+/*!
+  \return Rtti_Transform
+  \sa isEqual()
+ */
+int QwtTransform::rtti() const
+{
+    return Rtti_Transform;
+}
+
+/*!
+  \brief Compare 2 transformations
+
+  Transformations are equal, when they map all values to the same 
+  values. Caches of mapped coordinates - like the one of 
+  QwtSharedXColumnData - depend on this comparison, as the scale maps
+  of a plot are copied, including their transformations, for each replot.
+
+  As the default implementation doesn't know the parameters of
+  a derived class it is true for the same object only.
+  A derived class should overload rtti() and isEqual().
+
+  \param other Other transformation
+  \return true, when both transformations are equal
+
+  \sa rtti(), QwtScaleMap::operator==()
+ */
+bool QwtTransform::isEqual( const QwtTransform *other ) const
+{
+    return other == this;
+}
+
 /*! 
   \param value Value to be bounded
   \return value unmodified
@@ -39,6 +71,44 @@ double QwtTransform::bounded( double value ) const
     return value;
 }
 
+/*!
+  \brief Transform an array of values
+
+  The default implementation calls transform() for each value.
+
+  \param values Values to be transformed
+  \param result Array for the transformed values, might be
+                the same as values
+  \param count Number of values
+
+  \sa transform(), QwtScaleMap::transform()
+ */
+void QwtTransform::transformValues( const double *values,
+    double *result, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+        result[i] = transform( values[i] );
+}
+
+/*!
+  \brief Inverse transformation of an array of values
+
+  The default implementation calls invTransform() for each value.
+
+  \param values Values to be transformed
+  \param result Array for the transformed values, might be
+                the same as values
+  \param count Number of values
+
+  \sa invTransform(), QwtScaleMap::invTransform()
+ */
+void QwtTransform::invTransformValues( const double *values,
+    double *result, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+        result[i] = invTransform( values[i] );
+}
+
 //! Constructor
 QwtNullTransform::QwtNullTransform():
     QwtTransform()
@@ -68,12 +138,51 @@ double QwtNullTransform::invTransform( double value ) const
     return value;
 }
 
+/*! 
+  \param values Values to be transformed
+  \param result Array for the unmodified values
+  \param count Number of values
+ */
+void QwtNullTransform::transformValues( const double *values,
+    double *result, int count ) const
+{
+    if ( result != values )
+        ::memcpy( result, values, count * sizeof( double ) );
+}
+
+/*! 
+  \param values Values to be transformed
+  \param result Array for the unmodified values
+  \param count Number of values
+ */
+void QwtNullTransform::invTransformValues( const double *values,
+    double *result, int count ) const
+{
+    if ( result != values )
+        ::memcpy( result, values, count * sizeof( double ) );
+}
+
 //! \return Clone of the transformation
 QwtTransform *QwtNullTransform::copy() const
 {
     return new QwtNullTransform();
 }
 
+//! \return Rtti_NullTransform
+int QwtNullTransform::rtti() const
+{
+    return Rtti_NullTransform;
+}
+
+/*!
+  \param other Other transformation
+  \return true, when other is also a QwtNullTransform
+ */
+bool QwtNullTransform::isEqual( const QwtTransform *other ) const
+{
+    return other && other->rtti() == Rtti_NullTransform;
+}
+
 //! Constructor
 QwtLogTransform::QwtLogTransform():
     QwtTransform()
@@ -103,6 +212,30 @@ double QwtLogTransform::invTransform( double value ) const
     return qExp( value );
 }
 
+/*! 
+  \param values Values to be transformed
+  \param result Array for log( value )
+  \param count Number of values
+ */
+void QwtLogTransform::transformValues( const double *values,
+    double *result, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+        result[i] = ::log( values[i] );
+}
+
+/*! 
+  \param values Values to be transformed
+  \param result Array for exp( value )
+  \param count Number of values
+ */
+void QwtLogTransform::invTransformValues( const double *values,
+    double *result, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+        result[i] = qExp( values[i] );
+}
+
 /*! 
   \param value Value to be bounded
   \return qBound( LogMin, value, LogMax )
@@ -118,6 +251,21 @@ QwtTransform *QwtLogTransform::copy() const
     return new QwtLogTransform();
 }
 
+//! \return Rtti_LogTransform
+int QwtLogTransform::rtti() const
+{
+    return Rtti_LogTransform;
+}
+
+/*!
+  \param other Other transformation
+  \return true, when other is also a QwtLogTransform
+ */
+bool QwtLogTransform::isEqual( const QwtTransform *other ) const
+{
+    return other && other->rtti() == Rtti_LogTransform;
+}
+
 /*!
   Constructor
   \param exponent Exponent
@@ -158,8 +306,67 @@ double QwtPowerTransform::invTransform( double value ) const
         return qPow( value, d_exponent );
 }
 
+/*! 
+  \param values Values to be transformed
+  \param result Array for the exponentiations preserving the sign
+  \param count Number of values
+ */
+void QwtPowerTransform::transformValues( const double *values,
+    double *result, int count ) const
+{
+    const double exponent = 1.0 / d_exponent;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+        result[i] = ( value < 0.0 ) 
+            ? -qPow( -value, exponent ) : qPow( value, exponent );
+    }
+}
+
+/*! 
+  \param values Values to be transformed
+  \param result Array for the inverse exponentiations preserving the sign
+  \param count Number of values
+ */
+void QwtPowerTransform::invTransformValues( const double *values,
+    double *result, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+        result[i] = ( value < 0.0 ) 
+            ? -qPow( -value, d_exponent ) : qPow( value, d_exponent );
+    }
+}
+
 //! \return Clone of the transformation
 QwtTransform *QwtPowerTransform::copy() const
 {
     return new QwtPowerTransform( d_exponent );
 }
+
+//! \return Rtti_PowerTransform
+int QwtPowerTransform::rtti() const
+{
+    return Rtti_PowerTransform;
+}
+
+/*!
+  \param other Other transformation
+  \return true, when other is a QwtPowerTransform with the same exponent
+ */
+bool QwtPowerTransform::isEqual( const QwtTransform *other ) const
+{
+    if ( other == NULL || other->rtti() != Rtti_PowerTransform )
+        return false;
+
+    return static_cast<const QwtPowerTransform *>( other )->exponent() 
+        == d_exponent;
+}
+
+//! \return Exponent of the transformation
+double QwtPowerTransform::exponent() const
+{
+    return d_exponent;
+}
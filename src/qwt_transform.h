@@ -35,9 +35,40 @@
 class QWT_EXPORT QwtTransform
 {
 public:
+    /*!
+      \brief Runtime type information
+
+      RttiValues is used to identify the type of a transformation,
+      when comparing transformations ( isEqual() ).
+      Values >= Rtti_UserTransform are reserved for applications.
+     */
+    enum RttiValues
+    {
+        //! Unspecified transformation
+        Rtti_Transform = 0,
+
+        //! For QwtNullTransform
+        Rtti_NullTransform,
+
+        //! For QwtLogTransform
+        Rtti_LogTransform,
+
+        //! For QwtPowerTransform
+        Rtti_PowerTransform,
+
+        /*!
+           Values >= Rtti_UserTransform are reserved for 
+           transformations not implemented in the Qwt library.
+         */
+        Rtti_UserTransform = 1000
+    };
+
     QwtTransform();
     virtual ~QwtTransform();
 
+    virtual int rtti() const;
+    virtual bool isEqual( const QwtTransform * ) const;
+
     /*!
        Modify value to be a valid value for the transformation.
        The default implementation does nothing.
@@ -64,6 +95,12 @@ public:
      */
     virtual double invTransform( double value ) const = 0;
 
+    virtual void transformValues( const double *values,
+        double *result, int count ) const;
+
+    virtual void invTransformValues( const double *values,
+        double *result, int count ) const;
+
     //! Virtualized copy operation
     virtual QwtTransform *copy() const = 0;
 
@@ -86,7 +123,16 @@ public:
     virtual double transform( double value ) const;
     virtual double invTransform( double value ) const;
 
+    virtual void transformValues( const double *values,
+        double *result, int count ) const;
+
+    virtual void invTransformValues( const double *values,
+        double *result, int count ) const;
+
     virtual QwtTransform *copy() const;
+
+    virtual int rtti() const;
+    virtual bool isEqual( const QwtTransform * ) const;
 };
 /*!
    \brief Logarithmic transformation
@@ -106,10 +152,19 @@ public:
     virtual double transform( double value ) const;
     virtual double invTransform( double value ) const;
 
+    virtual void transformValues( const double *values,
+        double *result, int count ) const;
+
+    virtual void invTransformValues( const double *values,
+        double *result, int count ) const;
+
     virtual double bounded( double value ) const;
 
     virtual QwtTransform *copy() const;
 
+    virtual int rtti() const;
+    virtual bool isEqual( const QwtTransform * ) const;
+
     static const double LogMin;
     static const double LogMax;
 };
@@ -131,8 +186,19 @@ public:
     virtual double transform( double value ) const;
     virtual double invTransform( double value ) const;
 
+    virtual void transformValues( const double *values,
+        double *result, int count ) const;
+
+    virtual void invTransformValues( const double *values,
+        double *result, int count ) const;
+
     virtual QwtTransform *copy() const;
 
+    virtual int rtti() const;
+    virtual bool isEqual( const QwtTransform * ) const;
+
+    double exponent() const;
+
 private:
     const double d_exponent;
 };
@@ -150,6 +150,16 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_series_data.h \
         qwt_series_store.h \
         qwt_point_data.h \
+        qwt_series_loader.h \
+        qwt_item_model_data.h \
+        qwt_compressed_point_data.h \
+        qwt_shared_column_data.h \
+        qwt_mapped_point_data.h \
+        qwt_point_stream_data.h \
+        qwt_ring_buffer_data.h \
+        qwt_spatial_index.h \
+        qwt_point_pyramid_data.h \
+        qwt_minmax_pyramid.h \
         qwt_scale_widget.h 
 
     SOURCES += \
@@ -199,6 +209,16 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_sampling_thread.cpp \
         qwt_series_data.cpp \
         qwt_point_data.cpp \
+        qwt_series_loader.cpp \
+        qwt_item_model_data.cpp \
+        qwt_compressed_point_data.cpp \
+        qwt_shared_column_data.cpp \
+        qwt_mapped_point_data.cpp \
+        qwt_point_stream_data.cpp \
+        qwt_ring_buffer_data.cpp \
+        qwt_spatial_index.cpp \
+        qwt_point_pyramid_data.cpp \
+        qwt_minmax_pyramid.cpp \
         qwt_scale_widget.cpp 
 
     contains(QWT_CONFIG, QwtOpenGL) {
@@ -0,0 +1,276 @@
+#include <qwt_compressed_point_data.h>
+#include <qvector.h>
+#include <qdebug.h>
+#include <qmath.h>
+#include <float.h>
+#include <string.h>
+
+#define DEBUG_ERRORS 1
+
+/*
+  Round trip test for QwtCompressedPointData: the samples have to
+  come back with identical bit patterns - including NaNs with 
+  payloads and the sign of zeros.
+ */
+
+static inline quint64 toBits( double value )
+{
+    quint64 bits;
+    ::memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+static inline double fromBits( quint64 bits )
+{
+    double value;
+    ::memcpy( &value, &bits, sizeof( value ) );
+
+    return value;
+}
+
+static inline bool isIdentical( const QPointF &p1, const QPointF &p2 )
+{
+    return toBits( p1.x() ) == toBits( p2.x() ) 
+        && toBits( p1.y() ) == toBits( p2.y() );
+}
+
+// xorshift, to have the same "random" values on all platforms
+static quint64 randomBits()
+{
+    static quint64 state = Q_UINT64_C( 0x2545f4914f6cdd1d );
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+static int verifySamples( const QwtCompressedPointData &data, 
+    const QVector<QPointF> &samples )
+{
+    int numErrors = 0;
+
+    if ( data.size() != size_t( samples.size() ) )
+        return samples.size() + 1;
+
+    for ( int i = 0; i < samples.size(); i++ )
+    {
+        if ( !isIdentical( data.sample( i ), samples[i] ) )
+        {
+#if DEBUG_ERRORS > 0
+            qDebug() << "  sample" << i << data.sample( i ) << samples[i];
+#endif
+            numErrors++;
+        }
+    }
+
+    // blocks of samples, crossing the borders of the compressed blocks
+
+    const int blockSize = 333;
+
+    QVector<QPointF> buffer( blockSize );
+    for ( int from = 0; from < samples.size(); from += blockSize )
+    {
+        const int count = qMin( blockSize, samples.size() - from );
+        data.copySamples( from, count, buffer.data() );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            if ( !isIdentical( buffer[i], samples[from + i] ) )
+                numErrors++;
+        }
+    }
+
+    return numErrors;
+}
+
+static bool testRoundTrip( const char *name, const QVector<QPointF> &samples )
+{
+    int numErrors = 0;
+
+    // compressing all samples at once
+
+    QwtCompressedPointData data1( samples );
+    numErrors += verifySamples( data1, samples );
+
+    // appending the samples one by one, with a cache for one 
+    // block only, so that blocks are decoded again and again
+
+    QwtCompressedPointData data2;
+    data2.setCacheSize( 1 );
+
+    for ( int i = 0; i < samples.size(); i++ )
+        data2.append( samples[i] );
+
+    numErrors += verifySamples( data2, samples );
+
+    // appending in pieces, that don't match the blocks
+
+    QwtCompressedPointData data3;
+    for ( int i = 0; i < samples.size(); i += 100 )
+    {
+        const int count = qMin( 100, samples.size() - i );
+        data3.append( samples.constData() + i, count );
+    }
+
+    numErrors += verifySamples( data3, samples );
+
+    qDebug() << name << "(" << samples.size() << "):" << ( numErrors == 0 );
+
+    return numErrors == 0;
+}
+
+static QVector<QPointF> identicalValues( int numSamples )
+{
+    return QVector<QPointF>( numSamples, QPointF( 1.5, -2.25 ) );
+}
+
+static QVector<QPointF> specialValues( int numSamples )
+{
+    const double values[] =
+    {
+        qQNaN(),
+        -qQNaN(),
+        fromBits( Q_UINT64_C( 0x7ff0000000000001 ) ), // signaling NaN
+        fromBits( Q_UINT64_C( 0xfff8dead0000beef ) ), // NaN with payload
+        0.0,
+        -0.0,
+        qInf(),
+        -qInf(),
+        DBL_MAX,
+        -DBL_MAX,
+        DBL_MIN,
+        fromBits( 1 ), // smallest denormal
+        1.0,
+        1.0
+    };
+
+    const int numValues = sizeof( values ) / sizeof( values[0] );
+
+    QVector<QPointF> samples;
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        samples += QPointF( values[ i % numValues ], 
+            values[ ( 3 * i + 5 ) % numValues ] );
+    }
+
+    return samples;
+}
+
+static QVector<QPointF> largeDeltas( int numSamples )
+{
+    // deltas and deltas of deltas, that need all 64 bits
+
+    const quint64 bits[] =
+    {
+        Q_UINT64_C( 0x0000000000000000 ),
+        Q_UINT64_C( 0xffffffffffffffff ),
+        Q_UINT64_C( 0x8000000000000000 ),
+        Q_UINT64_C( 0x7fffffffffffffff ),
+        Q_UINT64_C( 0x0000000000000001 ),
+        Q_UINT64_C( 0xfffffffffffffffe )
+    };
+
+    const int numBits = sizeof( bits ) / sizeof( bits[0] );
+
+    QVector<QPointF> samples;
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        samples += QPointF( fromBits( bits[ i % numBits ] ),
+            fromBits( bits[ ( i / 2 ) % numBits ] ) );
+    }
+
+    return samples;
+}
+
+static QVector<QPointF> varyingDeltas( int numSamples )
+{
+    // deltas of deltas and XORed bits of all lengths
+
+    quint64 x = toBits( 1.0 );
+    quint64 y = toBits( 1.0 );
+    quint64 delta = 0;
+
+    QVector<QPointF> samples;
+    for ( int i = 0; i < numSamples; i++ )
+    {
+        const int numBits = i % 65;
+
+        quint64 bits = randomBits();
+        if ( numBits < 64 )
+            bits &= ( Q_UINT64_C( 1 ) << numBits ) - 1;
+
+        if ( i % 2 )
+            delta += bits;
+        else
+            delta -= bits;
+
+        x += delta;
+        y ^= bits << ( i % 11 );
+
+        samples += QPointF( fromBits( x ), fromBits( y ) );
+    }
+
+    return samples;
+}
+
+static QVector<QPointF> randomValues( int numSamples )
+{
+    QVector<QPointF> samples;
+    for ( int i = 0; i < numSamples; i++ )
+        samples += QPointF( fromBits( randomBits() ), fromBits( randomBits() ) );
+
+    return samples;
+}
+
+static QVector<QPointF> timeSeries( int numSamples )
+{
+    QVector<QPointF> samples;
+    for ( int i = 0; i < numSamples; i++ )
+        samples += QPointF( 1.0e9 + i * 0.001, qSin( i * 0.01 ) );
+
+    return samples;
+}
+
+int main()
+{
+    typedef QVector<QPointF> ( *Generator )( int );
+
+    const struct
+    {
+        const char *name;
+        Generator generator;
+    } tests[] =
+    {
+        { "Identical Values", identicalValues },
+        { "NaN, Zeros, Infinity", specialValues },
+        { "64 Bit Deltas", largeDeltas },
+        { "Varying Deltas", varyingDeltas },
+        { "Random Bits", randomValues },
+        { "Time Series", timeSeries }
+    };
+
+    const int blockSize = QwtCompressedPointData::BlockSize;
+
+    // empty, partial, complete and several blocks 
+    const int sizes[] = 
+    { 
+        0, 1, 2, blockSize - 1, blockSize, 
+        blockSize + 1, 3 * blockSize + 17
+    };
+
+    int numFailed = 0;
+
+    for ( uint i = 0; i < sizeof( tests ) / sizeof( tests[0] ); i++ )
+    {
+        for ( uint j = 0; j < sizeof( sizes ) / sizeof( sizes[0] ); j++ )
+        {
+            if ( !testRoundTrip( tests[i].name, tests[i].generator( sizes[j] ) ) )
+                numFailed++;
+        }
+    }
+
+    return ( numFailed == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include <qwt_series_loader.h>
+#include <qwt_plot_curve.h>
+#include <qapplication.h>
+#include <qeventloop.h>
+#include <qtemporaryfile.h>
+#include <qtimer.h>
+#include <qdebug.h>
+#include <qmath.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DEBUG_ERRORS 1
+
+/*
+  QwtSeriesLoader parses numbers with a fast path for up to 15 
+  significant digits and small exponents. The values of a CSV file 
+  have to be identical to the ones of QByteArray::toDouble(),
+  lines with values, that can't be parsed, have to be skipped.
+ */
+
+static inline quint64 toBits( double value )
+{
+    quint64 bits;
+    ::memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+static inline bool isIdentical( double value1, double value2 )
+{
+    if ( qIsNaN( value1 ) || qIsNaN( value2 ) )
+        return qIsNaN( value1 ) && qIsNaN( value2 );
+
+    return toBits( value1 ) == toBits( value2 );
+}
+
+static QList<QByteArray> boundaryValues()
+{
+    const char *values[] =
+    {
+        // signs and leading zeros
+        "0", "-0", "+0", "+1", "-1", "007", "-007.50", "000.000125", 
+        "0000000000000000000001", "0.0000000000000000000001",
+
+        // 15 and 16 significant digits
+        "123456789012345", "-999999999999999", "1234567890123456", 
+        "9999999999999999", "9007199254740993", "0.123456789012345", 
+        "0.1234567890123456", "1.00000000000000", "1.000000000000001",
+        "123456789012345000", "12345678901234.5", "1234567890123.456",
+
+        // exponents around 22
+        "1e22", "1e23", "1e-22", "1e-23", "1E22", "1E-23",
+        "-1.5e+22", "4.35e-23", "9.999999999999999e22",
+        "123456789012345e22", "123456789012345e-22", 
+        "123456789012345e23", "123456789012345e-23",
+        "0.1e23", "10e22", "0.000001e-17",
+
+        // incomplete numbers
+        "1e", "1e+", "1e-", "-", "+", ".", "-.", "e5", ".e5",
+        "-.5", "5.", ".5e1", "1.e2",
+
+        // no numbers
+        "nan", "NaN", "-nan", "inf", "-inf", "infinity", "abc", "",
+        "1.0.0", "1e5.5", "0x10", "1d", "12 34", "--1", "+-1",
+
+        // huge and tiny values
+        "1.7976931348623157e308", "1.8e308", "1e400", "4.9e-324", 
+        "2.2250738585072014e-308", "1e-400",
+
+        // surrounding whitespace
+        " 42", "42 ", "\t-3.25\t"
+    };
+
+    QList<QByteArray> list;
+    for ( uint i = 0; i < sizeof( values ) / sizeof( values[0] ); i++ )
+        list += QByteArray( values[i] );
+
+    // random values with different numbers of digits
+
+    qsrand( 4711 );
+
+    char buffer[64];
+    for ( int i = 0; i < 20000; i++ )
+    {
+        const double value = ( qrand() - RAND_MAX / 2 ) 
+            * qPow( 10.0, qrand() % 60 - 30 ) / ( qrand() + 1.0 );
+
+        const int precision = 1 + i % 18;
+        ::sprintf( buffer, "%.*g", precision, value );
+
+        list += QByteArray( buffer );
+    }
+
+    return list;
+}
+
+static bool testCsv( const char *name, const QList<QByteArray> &values, 
+    const char *lineEnd )
+{
+    QTemporaryFile file;
+    if ( !file.open() )
+    {
+        qDebug() << name << ": can't create a temporary file";
+        return false;
+    }
+
+    // x is the line number, what is always parsed by the fast path
+
+    QByteArray text;
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        text += QByteArray::number( i );
+        text += ',';
+        text += values[i];
+        text += lineEnd;
+    }
+
+    file.write( text );
+    file.flush();
+
+    QwtPlotCurve curve;
+
+    QwtSeriesLoader loader;
+    loader.setColumns( 0, 1 );
+    loader.setSeparator( ',' );
+
+    QEventLoop eventLoop;
+    QObject::connect( &loader, SIGNAL( finished() ), &eventLoop, SLOT( quit() ) );
+    QTimer::singleShot( 30000, &eventLoop, SLOT( quit() ) );
+
+    if ( !loader.load( file.fileName(), &curve ) )
+    {
+        qDebug() << name << ": can't load" << file.fileName();
+        return false;
+    }
+
+    eventLoop.exec();
+
+    int numErrors = 0;
+
+    int index = 0;
+    for ( int i = 0; i < values.size(); i++ )
+    {
+        bool ok;
+        const double expected = values[i].trimmed().toDouble( &ok );
+
+        const bool isLoaded = ( index < int( curve.dataSize() ) ) 
+            && curve.sample( index ).x() == i;
+
+        if ( isLoaded != ok 
+            || ( ok && !isIdentical( curve.sample( index ).y(), expected ) ) )
+        {
+#if DEBUG_ERRORS > 0
+            qDebug() << "  " << values[i] << ": expected" << ok << expected
+                << "loaded" << isLoaded 
+                << ( isLoaded ? curve.sample( index ).y() : 0.0 );
+#endif
+            numErrors++;
+        }
+
+        if ( isLoaded )
+            index++;
+    }
+
+    if ( index != int( curve.dataSize() ) )
+        numErrors++;
+
+    qDebug() << name << "(" << values.size() << "):" << ( numErrors == 0 );
+
+    return numErrors == 0;
+}
+
+int main( int argc, char **argv )
+{
+    QApplication app( argc, argv );
+
+    const QList<QByteArray> values = boundaryValues();
+
+    int numFailed = 0;
+
+    if ( !testCsv( "LF", values, "\n" ) )
+        numFailed++;
+
+    if ( !testCsv( "CRLF", values, "\r\n" ) )
+        numFailed++;
+
+    return ( numFailed == 0 ) ? 0 : 1;
+}